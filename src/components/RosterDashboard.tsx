@@ -219,19 +219,10 @@ export default function RosterDashboard() {
             setSelectedIndices(new Set());
             setSelectedPlayerIndex(null);
 
-            const count = eng.getPlayerCount();
-            const playerList: PlayerData[] = [];
-            for (let i = 0; i < count; i++) {
-                playerList.push(eng.getPlayer(i));
-            }
-            setPlayers(playerList);
+            setPlayers(eng.getPlayers());
 
             // Extract Teams
-            const teamCount = eng.getTeamCount();
-            const teamList: import('../engine/RosterEngine').TeamData[] = [];
-            for (let i = 0; i < teamCount; i++) {
-                teamList.push(eng.getTeam(i));
-            }
+            const teamList = eng.getTeams();
             setTeams(teamList);
 
             setCurrentPage(0);
@@ -240,7 +231,7 @@ export default function RosterDashboard() {
             setSortDir('asc');
 
             const engineLabel = eng.type === 'wasm' ? '⚡ Wasm C++' : '🔧 JS';
-            toast.success(`Loaded ${count} players & ${teamCount} teams via ${engineLabel} engine (${Math.round(elapsed)}ms)`);
+            toast.success(`Loaded ${count} players & ${teamList.length} teams via ${engineLabel} engine (${Math.round(elapsed)}ms)`);
         } catch (err) {
             console.error('Failed to parse .ROS file:', err);
             toast.error(`Error: ${err instanceof Error ? err.message : 'Unknown error'}`);
@@ -438,9 +429,7 @@ export default function RosterDashboard() {
     const handleExport = () => {
         if (!engine) return;
         try {
-            const data = engine.saveAndRecalculateChecksum();
-            const arrayBuffer = data.buffer.slice(data.byteOffset, data.byteOffset + data.byteLength) as ArrayBuffer;
-            const blob = new Blob([arrayBuffer], { type: 'application/octet-stream' });
+            const blob = engine.saveToBlob();
             const url = URL.createObjectURL(blob);
             const a = document.createElement('a');
             a.href = url;
@@ -699,10 +688,7 @@ export default function RosterDashboard() {
                                                     engine.setCFID(idx, val);
                                                 });
                                                 toast.success(`Updated CFID to ${val} for ${selectedIndices.size} players`);
-                                                const count = engine.getPlayerCount();
-                                                const newList: PlayerData[] = [];
-                                                for (let i = 0; i < count; i++) newList.push(engine.getPlayer(i));
-                                                setPlayers(newList);
+                                                setPlayers(engine.getPlayers());
                                             }
                                         }}
                                     >
@@ -725,15 +711,9 @@ export default function RosterDashboard() {
                                             toast.success(`Released ${successCount} players to Free Agency.`);
 
                                             // Sync state
-                                            const count = engine.getPlayerCount();
-                                            const newList: PlayerData[] = [];
-                                            for (let i = 0; i < count; i++) newList.push(engine.getPlayer(i));
-                                            setPlayers(newList);
+                                            setPlayers(engine.getPlayers());
 
-                                            const teamCount = engine.getTeamCount();
-                                            const newTeams = [];
-                                            for (let i = 0; i < teamCount; i++) newTeams.push(engine.getTeam(i));
-                                            setTeams(newTeams);
+                                            setTeams(engine.getTeams());
 
                                             setSelectedIndices(new Set());
                                         }}
@@ -1106,10 +1086,7 @@ export default function RosterDashboard() {
                                                                 const updatedPlayer = engine.getPlayer(profilePlayer.index);
                                                                 setPlayers(prev => prev.map(p => p.index === profilePlayer.index ? updatedPlayer : p));
 
-                                                                const teamCount = engine.getTeamCount();
-                                                                const newTeams = [];
-                                                                for (let i = 0; i < teamCount; i++) newTeams.push(engine.getTeam(i));
-                                                                setTeams(newTeams);
+                                                                setTeams(engine.getTeams());
 
                                                                 toast.success(newTeamIndex === null ? "Released to free agency" : "Trade successful");
                                                             } catch (err) {
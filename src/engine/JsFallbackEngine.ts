@@ -211,6 +211,12 @@ export class JsFallbackEngine implements IRosterEngine {
         return this.playerCount_;
     }
 
+    getPlayers(): PlayerData[] {
+        const players: PlayerData[] = [];
+        for (let i = 0; i < this.playerCount_; i++) players.push(this.getPlayer(i));
+        return players;
+    }
+
     getPlayer(index: number): PlayerData {
         const rec = this.recordStart(index);
 
@@ -492,6 +498,12 @@ export class JsFallbackEngine implements IRosterEngine {
         return this.teamCount_;
     }
 
+    getTeams(): import('./RosterEngine').TeamData[] {
+        const teams = [];
+        for (let i = 0; i < this.teamCount_; i++) teams.push(this.getTeam(i));
+        return teams;
+    }
+
     getTeam(index: number): import('./RosterEngine').TeamData {
         if (index < 0 || index >= this.teamCount_) {
             throw new Error(`JsFallbackEngine: team index ${index} out of bounds`);
@@ -725,6 +737,10 @@ export class JsFallbackEngine implements IRosterEngine {
         return new Uint8Array(this.buffer);
     }
 
+    saveToBlob(): Blob {
+        return new Blob([this.saveAndRecalculateChecksum()], { type: 'application/octet-stream' });
+    }
+
     save_and_recalculate_checksum(): void {
         this.saveAndRecalculateChecksum();
     }
@@ -487,6 +487,8 @@ export interface IRosterEngine {
 
     getPlayerCount(): number;
     getPlayer(index: number): PlayerData;
+    /** Every player, in index order */
+    getPlayers(): PlayerData[];
 
     setCFID(index: number, cfid: number): void;
 
@@ -507,12 +509,16 @@ export interface IRosterEngine {
     // Team Data
     getTeamCount(): number;
     getTeam(index: number): TeamData;
+    /** Every team, in table order (one bulk decode where the engine supports it) */
+    getTeams(): TeamData[];
     setTeamProperty(index: number, property: TeamProperty, value: string | number): void;
 
     /** Move a player between teams or to free agency (newTeamIndex = null) */
     updateRosterAssignment(playerIndex: number, newTeamIndex: number | null): void;
 
     saveAndRecalculateChecksum(): Uint8Array;
+    /** Checksummed file as a Blob, built without staging a full copy where the engine can stream */
+    saveToBlob(): Blob;
     getFileSize(): number;
 
     /** Free any allocated memory (Wasm heap, etc.) */
@@ -2,7 +2,8 @@
 // WasmEngine.ts — Emscripten Wasm engine with zero-copy memory management
 // ============================================================================
 // Wraps the compiled C++ RosterEditor via Embind bindings.
-// Uses Module._malloc / HEAPU8.set() for zero-copy file upload.
+// The file is read straight into an editor-owned heap buffer (prepare_load)
+// and exported through a heap view; older builds fall back to _malloc.
 // ============================================================================
 
 import type { IRosterEngine, PlayerData, RatingField, TendencyField, TeamProperty } from './RosterEngine';
@@ -29,6 +30,27 @@ const TENDENCY_CPP_MAP: Record<TendencyField, string> = {
 };
 
 
+/** Chunk size for streaming export (matches the C++ CRC slice) */
+const EXPORT_CHUNK_SIZE = 1 << 20;
+
+/** Byte size of one C++ TeamInfo record written by decode_teams */
+const TEAM_INFO_SIZE = 116;
+
+const utf8 = new TextDecoder();
+
+/** Blob and TextDecoder reject views over the threaded build's shared heap */
+function isSharedHeap(heap: Uint8Array): boolean {
+    return typeof SharedArrayBuffer !== 'undefined' && heap.buffer instanceof SharedArrayBuffer;
+}
+
+/** Decode a NUL-terminated string of at most maxLen bytes from the heap */
+function readCString(heap: Uint8Array, ptr: number, maxLen: number): string {
+    let end = ptr;
+    while (end < ptr + maxLen && heap[end] !== 0) end++;
+    const bytes = heap.subarray(ptr, end);
+    return utf8.decode(isSharedHeap(heap) ? bytes.slice() : bytes);
+}
+
 /** Helper to safely call a method on an Embind proxy then delete it */
 function deleteProxy(proxy: unknown): void {
     (proxy as { delete: () => void }).delete();
@@ -39,7 +61,7 @@ export class WasmEngine implements IRosterEngine {
 
     private module: RosterEditorModule;
     private editor: WasmRosterEditor;
-    private heapPtr: number;
+    private heapPtr: number;          // 0 when the editor owns the buffer (prepare_load)
     private bufferLength: number;
 
     constructor(module: RosterEditorModule, editor: WasmRosterEditor, heapPtr: number, bufferLength: number) {
@@ -51,21 +73,44 @@ export class WasmEngine implements IRosterEngine {
 
     static async create(fileBuffer: ArrayBuffer): Promise<WasmEngine> {
         const module = await WasmEngine.loadEmscriptenModule();
-        const ptr = module._malloc(fileBuffer.byteLength);
-        if (ptr === 0) throw new Error('Failed to allocate memory on Wasm heap');
-
-        module.HEAPU8.set(new Uint8Array(fileBuffer), ptr);
-
+        const length = fileBuffer.byteLength;
         const editor = new module.RosterEditor();
+        const owned = typeof editor.prepare_load === 'function';
+        let ptr = 0;
+
         try {
-            editor.init(ptr, fileBuffer.byteLength);
+            if (owned) {
+                // The editor owns (and frees) the buffer; write the file
+                // straight into it — no staging allocation on the heap.
+                const view = editor.prepare_load(length);
+                if (!view) throw new Error('Failed to allocate memory on Wasm heap');
+                view.set(new Uint8Array(fileBuffer));
+            } else {
+                ptr = module._malloc(length);
+                if (ptr === 0) throw new Error('Failed to allocate memory on Wasm heap');
+                module.HEAPU8.set(new Uint8Array(fileBuffer), ptr);
+            }
+
+            if (typeof editor.init_async === 'function') {
+                // Discovery runs on a worker in the threaded build; yield to
+                // the event loop until it finishes so the UI stays responsive.
+                const handle = owned ? editor.load_prepared_async() : editor.init_async(ptr, length);
+                while (!editor.is_task_done(handle)) {
+                    await new Promise((resolve) => setTimeout(resolve, 0));
+                }
+                editor.wait_task(handle);
+            } else if (owned) {
+                editor.load_prepared();
+            } else {
+                editor.init(ptr, length);
+            }
         } catch (err) {
             deleteProxy(editor);
-            module._free(ptr);
+            if (ptr !== 0) module._free(ptr);
             throw err;
         }
 
-        return new WasmEngine(module, editor, ptr, fileBuffer.byteLength);
+        return new WasmEngine(module, editor, ptr, length);
     }
 
     private static loadingPromise: Promise<RosterEditorModule> | null = null;
@@ -102,11 +147,77 @@ export class WasmEngine implements IRosterEngine {
         return WasmEngine.loadingPromise;
     }
 
+    /** Heap scratch for block reads, sized for the largest block (48 × uint32 gear) */
+    private scratchPtr = 0;
+
+    private scratch(): number {
+        if (this.scratchPtr === 0) {
+            this.scratchPtr = this.module._malloc(48 * 4);
+            if (this.scratchPtr === 0) throw new Error('Failed to allocate memory on Wasm heap');
+        }
+        return this.scratchPtr;
+    }
+
+    /** Run a C++ block read into the scratch buffer and return the bytes it wrote */
+    private readU8Block(read: (ptr: number) => number): number[] {
+        const ptr = this.scratch();
+        const n = read(ptr);
+        return Array.from(this.module.HEAPU8.subarray(ptr, ptr + n));
+    }
+
     getPlayerCount(): number {
         return this.editor.get_player_count();
     }
 
     getPlayer(index: number): PlayerData {
+        return this.readPlayer(index, this.nameReader(), null);
+    }
+
+    getPlayers(): PlayerData[] {
+        const count = this.editor.get_player_count();
+        const names = this.nameReader();
+        if (!names || typeof this.editor.export_player_name_ids !== 'function' || count === 0) {
+            const players: PlayerData[] = [];
+            for (let i = 0; i < count; i++) players.push(this.readPlayer(i, names, null));
+            return players;
+        }
+
+        // One C++ pass exports every player's [first, last] name ID pair.
+        const ptr = this.module._malloc(count * 4);
+        if (ptr === 0) throw new Error('Failed to allocate memory on Wasm heap');
+        try {
+            this.editor.export_player_name_ids(ptr);
+            const ids = new Uint16Array(this.module.HEAPU8.buffer, ptr, count * 2).slice();
+            const players: PlayerData[] = [];
+            for (let i = 0; i < count; i++) players.push(this.readPlayer(i, names, ids));
+            return players;
+        } finally {
+            this.module._free(ptr);
+        }
+    }
+
+    /**
+     * Name ID → string decoded straight from the engine's name pool, or null
+     * when the module lacks the pool API or the roster has no name table.
+     * Each lookup takes a fresh heap view, since reading players may grow it.
+     */
+    private nameReader(): ((id: number) => string) | null {
+        if (typeof this.editor.get_name_pool_ptr !== 'function') return null;
+        const count = this.editor.get_name_count();
+        const length = this.editor.get_name_pool_length();
+        if (count === 0 || length === 0) return null;
+        const poolPtr = this.editor.get_name_pool_ptr();
+        const offsetsPtr = this.editor.get_name_offsets_ptr();
+        return (id) => {
+            if (id >= count) return String(id);
+            const heap = this.module.HEAPU8;
+            const start = new DataView(heap.buffer, offsetsPtr + id * 4, 4).getUint32(0, true);
+            return readCString(heap, poolPtr + start, length - start);
+        };
+    }
+
+    /** Read one player; ids, when given, holds the exported name ID pairs */
+    private readPlayer(index: number, names: ((id: number) => string) | null, ids: Uint16Array | null): PlayerData {
         const p = this.editor.get_player(index);
         try {
             // Extract all 43 ratings via data-driven API
@@ -115,22 +226,39 @@ export class WasmEngine implements IRosterEngine {
                 ratings.push(p.get_rating_by_id(i));
             }
 
-            // Extract all 58 tendencies via data-driven API
-            const tendencies: number[] = [];
-            for (let i = 0; i < TENDENCY_DEFS.length; i++) {
-                tendencies.push(p.get_tendency_by_id(i));
+            // Tendencies, hot zones, sig skills and gear come back as whole
+            // blocks through a heap scratch buffer; older modules lack the
+            // block API and are read field by field.
+            const blocks = typeof p.read_gear_block === 'function';
+
+            // Extract all 58 tendencies
+            let tendencies: number[] = [];
+            if (blocks) {
+                tendencies = this.readU8Block((ptr) => p.read_tendency_block(ptr));
+            } else {
+                for (let i = 0; i < TENDENCY_DEFS.length; i++) {
+                    tendencies.push(p.get_tendency_by_id(i));
+                }
             }
 
             // Extract 14 hot zones
-            const hotZones: number[] = [];
-            for (let i = 0; i < 14; i++) {
-                hotZones.push(p.get_hot_zone(i));
+            let hotZones: number[] = [];
+            if (blocks) {
+                hotZones = this.readU8Block((ptr) => p.read_hot_zone_block(ptr));
+            } else {
+                for (let i = 0; i < 14; i++) {
+                    hotZones.push(p.get_hot_zone(i));
+                }
             }
 
             // Extract 5 signature skills
-            const sigSkills: number[] = [];
-            for (let i = 0; i < 5; i++) {
-                sigSkills.push(p.get_sig_skill(i));
+            let sigSkills: number[] = [];
+            if (blocks) {
+                sigSkills = this.readU8Block((ptr) => p.read_sig_skill_block(ptr));
+            } else {
+                for (let i = 0; i < 5; i++) {
+                    sigSkills.push(p.get_sig_skill(i));
+                }
             }
 
             // Extract 40 animations
@@ -139,9 +267,15 @@ export class WasmEngine implements IRosterEngine {
                 animations.push(p.get_animation_by_id(i));
             }
 
-            const gear: number[] = [];
-            for (let i = 0; i < 48; i++) {
-                gear.push(p.get_gear_by_id(i));
+            let gear: number[] = [];
+            if (blocks) {
+                const ptr = this.scratch();
+                const n = p.read_gear_block(ptr);
+                gear = Array.from(new Uint32Array(this.module.HEAPU8.buffer, ptr, n));
+            } else {
+                for (let i = 0; i < 48; i++) {
+                    gear.push(p.get_gear_by_id(i));
+                }
             }
 
             const vitals: number[] = [];
@@ -149,15 +283,20 @@ export class WasmEngine implements IRosterEngine {
                 vitals.push(p.get_vital_by_id(i));
             }
 
-            // Intercept Names and translate via Dictionary
-            const rawFirstName = p.get_first_name() || '';
-            const rawLastName = p.get_last_name() || '';
-
-            const firstId = parseInt(rawFirstName, 10);
-            const lastId = parseInt(rawLastName, 10);
+            // Names are resolved by the engine's name table. A bare numeric ID
+            // means the table wasn't found — translate via the static dictionary.
+            let rawFirstName: string;
+            let rawLastName: string;
+            if (names) {
+                rawFirstName = names(ids ? ids[index * 2] : p.get_first_name_id());
+                rawLastName = names(ids ? ids[index * 2 + 1] : p.get_last_name_id());
+            } else {
+                rawFirstName = p.get_first_name() || '';
+                rawLastName = p.get_last_name() || '';
+            }
 
-            const firstName = !isNaN(firstId) ? (ROSTER_NAMES[firstId] || rawFirstName) : rawFirstName;
-            const lastName = !isNaN(lastId) ? (ROSTER_NAMES[lastId] || rawLastName) : rawLastName;
+            const firstName = /^\d+$/.test(rawFirstName) ? (ROSTER_NAMES[Number(rawFirstName)] || rawFirstName) : rawFirstName;
+            const lastName = /^\d+$/.test(rawLastName) ? (ROSTER_NAMES[Number(rawLastName)] || rawLastName) : rawLastName;
 
             return {
                 index,
@@ -272,6 +411,43 @@ export class WasmEngine implements IRosterEngine {
         }
     }
 
+    getTeams(): import('./RosterEngine').TeamData[] {
+        const count = this.editor.get_team_count();
+        if (typeof this.editor.decode_teams !== 'function' || count === 0) {
+            const teams = [];
+            for (let i = 0; i < count; i++) teams.push(this.getTeam(i));
+            return teams;
+        }
+
+        // One C++ pass fills packed TeamInfo structs (see RosterEditor.hpp).
+        const ptr = this.module._malloc(count * TEAM_INFO_SIZE);
+        if (ptr === 0) throw new Error('Failed to allocate memory on Wasm heap');
+        try {
+            this.editor.decode_teams(ptr);
+            const heap = this.module.HEAPU8;
+            const view = new DataView(heap.buffer, ptr, count * TEAM_INFO_SIZE);
+            const teams: import('./RosterEngine').TeamData[] = [];
+            for (let i = 0; i < count; i++) {
+                const base = i * TEAM_INFO_SIZE;
+                const rosterIndices: number[] = [];
+                for (let s = 0; s < 15; s++) rosterIndices.push(view.getUint16(base + 12 + s * 2, true));
+                teams.push({
+                    index: view.getUint16(base + 8, true),
+                    teamId: view.getUint16(base + 10, true),
+                    city: readCString(heap, ptr + base + 44, 33),
+                    name: readCString(heap, ptr + base + 77, 33),
+                    abbr: readCString(heap, ptr + base + 110, 5),
+                    color1: view.getUint32(base, true),
+                    color2: view.getUint32(base + 4, true),
+                    rosterIndices,
+                });
+            }
+            return teams;
+        } finally {
+            this.module._free(ptr);
+        }
+    }
+
     setTeamProperty(index: number, property: TeamProperty, value: string | number): void {
         const t = this.editor.get_team(index);
         try {
@@ -394,17 +570,48 @@ export class WasmEngine implements IRosterEngine {
 
     saveAndRecalculateChecksum(): Uint8Array {
         this.editor.save_and_recalculate_checksum();
+        if (typeof this.editor.get_buffer_view === 'function') {
+            return this.editor.get_buffer_view().slice();
+        }
         const ptr = this.editor.get_buffer_ptr();
         const len = this.editor.get_buffer_length();
         return this.module.HEAPU8.slice(ptr, ptr + len);
     }
 
+    saveToBlob(): Blob {
+        if (typeof this.editor.get_buffer_view === 'function' && !isSharedHeap(this.module.HEAPU8)) {
+            // Blob copies the view synchronously: one copy, straight off the heap.
+            this.editor.save_and_recalculate_checksum();
+            return new Blob([this.editor.get_buffer_view()], { type: 'application/octet-stream' });
+        }
+        if (typeof this.editor.begin_export !== 'function') {
+            return new Blob([this.saveAndRecalculateChecksum()], { type: 'application/octet-stream' });
+        }
+
+        // Each chunk is hashed in C++ as it is copied out, so the heap buffer
+        // is read once and only one JS-side copy exists. The header is final
+        // after the last chunk; patch it into the copy of chunk 0.
+        const parts: Uint8Array[] = [];
+        this.editor.begin_export(EXPORT_CHUNK_SIZE);
+        for (let len = this.editor.next_export_chunk(); len > 0; len = this.editor.next_export_chunk()) {
+            const ptr = this.editor.get_export_chunk_ptr();
+            parts.push(this.module.HEAPU8.slice(ptr, ptr + len));
+        }
+        const header = this.editor.get_buffer_ptr();
+        if (parts.length > 0) parts[0].set(this.module.HEAPU8.subarray(header, header + 4));
+        return new Blob(parts, { type: 'application/octet-stream' });
+    }
+
     getFileSize(): number {
         return this.bufferLength;
     }
 
     dispose(): void {
         if (this.editor) deleteProxy(this.editor);
+        if (this.scratchPtr !== 0) {
+            this.module._free(this.scratchPtr);
+            this.scratchPtr = 0;
+        }
         if (this.heapPtr !== 0) {
             this.module._free(this.heapPtr);
             this.heapPtr = 0;
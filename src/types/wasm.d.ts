@@ -23,6 +23,10 @@ export interface WasmPlayer {
 
   get_first_name(): string;
   get_last_name(): string;
+  get_first_name_id(): number;
+  get_last_name_id(): number;
+  set_first_name(name: string): void;
+  set_last_name(name: string): void;
 
   get_position(): number;
 
@@ -35,6 +39,16 @@ export interface WasmPlayer {
   set_hot_zone(zoneId: number, value: number): void;
   get_sig_skill(slot: number): number;
   set_sig_skill(slot: number, value: number): void;
+  /** Block access: copy a whole block to/from Uint8 heap memory; returns the value count (58 / 14 / 5) */
+  read_tendency_block(out_ptr: number): number;
+  write_tendency_block(in_ptr: number): number;
+  read_hot_zone_block(out_ptr: number): number;
+  write_hot_zone_block(in_ptr: number): number;
+  read_sig_skill_block(out_ptr: number): number;
+  write_sig_skill_block(in_ptr: number): number;
+  /** All 48 gear fields as uint32 (GearID order); returns 48 */
+  read_gear_block(out_ptr: number): number;
+  write_gear_block(in_ptr: number): number;
 
   // -- Tendencies (bit-packed) --
   get_tendency_stepback_shot_3pt(): number;
@@ -85,20 +99,303 @@ export interface WasmTeam {
   delete(): void;
 }
 
+/** Field families for RosterTransform (matches C++ FieldKind) */
+export const enum WasmFieldKind {
+  Rating = 0,
+  Tendency = 1,
+  Animation = 2,
+  HotZone = 3,
+  SigSkill = 4,
+  Gear = 5,
+}
+
+/** Compiled roster-wide edit: filter + ordered steps (id -1 = every field of the kind) */
+export interface WasmRosterTransform {
+  where_positions(mask: number): void;
+  where_team(team_id: number): void;
+  where_range(kind: WasmFieldKind, id: number, lo: number, hi: number): void;
+  scale(kind: WasmFieldKind, id: number, factor: number): void;
+  add(kind: WasmFieldKind, id: number, delta: number): void;
+  clamp(kind: WasmFieldKind, id: number, lo: number, hi: number): void;
+  set(kind: WasmFieldKind, id: number, value: number): void;
+  copy_from(kind: WasmFieldKind, id: number, src_kind: WasmFieldKind, src_id: number): void;
+  clear(): void;
+  compile(): boolean;
+  get_step_count(): number;
+
+  /** Embind objects must be deleted to prevent memory leaks */
+  delete(): void;
+}
+
+/** Grouping for the stats_* queries (matches C++ StatsGroupBy) */
+export const enum WasmStatsGroupBy {
+  All = 0,
+  Team = 1,          // group = VITAL_TEAM_ID1 (255 = free agent)
+  Position = 2,      // group = 0..4 PG..C, 5 = unknown
+  TeamPosition = 3,  // group = team * 6 + position group
+}
+
+/** RosterEditor.validate issue codes (matches C++ IssueCode) */
+export const enum WasmIssueCode {
+  DuplicateRosterSlot = 1,
+  BadRosterSlot = 2,
+  TeamIdMismatch = 3,
+  FieldRange = 4,
+  DuplicateCfid = 5,
+}
+
+/** RosterEditor.drain_changes group bits (matches C++ ChangeGroup) */
+export const enum WasmChangeGroup {
+  Ratings = 1 << 0,
+  Tendencies = 1 << 1,   // Also hot zones and signature skills
+  Vitals = 1 << 2,
+  Gear = 1 << 3,
+  Animations = 1 << 4,
+  Identity = 1 << 5,     // Player CFID / names; team id, strings, colors
+  Roster = 1 << 6,       // Team roster slots
+}
+
+/** FieldSearch value transforms (matches C++ SearchTransform) */
+export const enum WasmSearchTransform {
+  Raw = 0,
+  Rating = 1,   // raw / 3 + 25
+  Mask7 = 2,    // low 7 bits
+}
+
+/** Known (player, value) observations for RosterEditor.find_field */
+export interface WasmFieldSearch {
+  add(player: number, value: number): void;
+  clear(): void;
+  get_observation_count(): number;
+  set_transform(transform: WasmSearchTransform): void;
+  set_widths(min_width: number, max_width: number): void;
+  set_tolerance(tolerance: number): void;
+  /** Inclusive byte window; last -1 = record end */
+  set_byte_range(first: number, last: number): void;
+  /** 0 = every observation must match */
+  set_min_matches(n: number): void;
+  delete(): void;
+}
+
+/** SimilaritySearch distance metrics (matches C++ SimilarityMetric) */
+export const enum WasmSimilarityMetric {
+  L2 = 0,       // Weighted Euclidean
+  Cosine = 1,   // 1 - weighted cosine similarity
+}
+
+/** Metric, weights and group filter for RosterEditor.find_similar */
+export interface WasmSimilaritySearch {
+  set_metric(metric: WasmSimilarityMetric): void;
+  /** Weights are >= 0 (default 1); 0 drops the field */
+  set_rating_weight(rating_id: number, weight: number): void;
+  set_tendency_weight(tendency_id: number, weight: number): void;
+  /** Append the 58 tendencies to the 43 ratings (default off) */
+  set_use_tendencies(enabled: boolean): void;
+  reset_weights(): void;
+  /** Only rank one group of a StatsGroupBy; group -1 = everyone */
+  set_group(group_by: WasmStatsGroupBy, group: number): void;
+  delete(): void;
+}
+
+/** RosterBalancer move kinds (matches C++ BalanceMove; combine with |) */
+export const enum WasmBalanceMove {
+  Adjust = 1,   // Change the field on individual players
+  Trade = 2,    // Swap players between selected teams
+}
+
+/** Team-average rebalancing plan for RosterEditor.plan_balance / apply_balance */
+export interface WasmRosterBalancer {
+  /** Default rating overall */
+  set_field(kind: WasmFieldKind, id: number): void;
+  /** No teams added = every team */
+  add_team(team: number): void;
+  clear_teams(): void;
+  /** Default target is the league mean of the selected teams */
+  set_target(value: number): void;
+  set_team_target(team: number, value: number): void;
+  clear_targets(): void;
+  /** Bit p = VITAL_POSITION p counts toward team averages; -1 = all */
+  set_position_mask(mask: number): void;
+  lock_player(player: number): void;
+  clear_locks(): void;
+  set_moves(mask: number): void;
+  /** Largest per-player change (default 3) */
+  set_max_adjust(points: number): void;
+  /** Trade only within a position row (default on) */
+  set_same_position_trades(enabled: boolean): void;
+  /** Objective cost per adjusted point and per trade, i.e. per two-player swap (default 0.02, 0.25) */
+  set_costs(per_point: number, per_trade: number): void;
+  set_iterations(n: number): void;
+  /** Parallel annealing chains (default 4) */
+  set_restarts(n: number): void;
+  set_seed(seed: number): void;
+  get_change_count(): number;
+  /** Writes 16-byte [player, from_team, to_team, delta] int32 records; returns the total */
+  get_changes(out_ptr: number, max_changes: number): number;
+  get_cost_before(): number;
+  get_cost_after(): number;
+  delete(): void;
+}
+
+/** Synthetic-player options for RosterEditor.generate_players */
+export interface WasmPlayerGenerator {
+  set_seed(seed: number): void;
+  /** VITAL_POSITION 0..4; -1 (default) = the roster's position mix */
+  set_position(position: number): void;
+  /** Added to every rating mean (default 0) */
+  set_quality(offset: number): void;
+  /** Scales deviations from the archetype mean (default 1) */
+  set_spread(scale: number): void;
+  /** Default 0, 0 = keep each donor's birth year */
+  set_birth_years(first: number, last: number): void;
+  /** Lowest CFID handed out (default 1) */
+  set_cfid_base(cfid: number): void;
+  delete(): void;
+}
+
 export interface WasmRosterEditor {
   init(buffer_ptr: number, buffer_length: number): void;
+  /** Editor-owned heap view to read the file into (null on failure); invalid after the next module call */
+  prepare_load(length: number): Uint8Array | null;
+  /** init() on the bytes written into the prepare_load view */
+  load_prepared(): void;
+  get_load_capacity(): number;
   get_player_count(): number;
   get_player(index: number): WasmPlayer;
+  copy_gear(from: number, to: number): void;
+  /** Whole-record operations; team roster slots are fixed up automatically */
+  clone_player(src: number, dst: number): boolean;
+  swap_players(a: number, b: number): boolean;
+  move_player(src: number, dst: number): boolean;
+  /** Lowest free player slot (null CFID, on no roster), reserved for the caller; -1 when full */
+  allocate_player_slot(): number;
+  release_player_slot(index: number): boolean;
+  get_free_slot_count(): number;
   get_team_count(): number;
   get_team(index: number): WasmTeam;
+  /** Fills get_team_count() packed 116-byte TeamInfo structs at out_ptr; returns the count */
+  decode_teams(out_ptr: number): number;
   save_and_recalculate_checksum(): void;
+  /** Streaming export: returns the chunk count; the CRC is computed as chunks are taken */
+  begin_export(chunk_size: number): number;
+  /** Next chunk's length (0 when done); the last one also writes the header into the buffer */
+  next_export_chunk(): number;
+  get_export_chunk_ptr(): number;
   get_buffer_ptr(): number;
   get_buffer_length(): number;
+  /** Heap view of the whole file; consume it before the next module call */
+  get_buffer_view(): Uint8Array;
+
+  // -- Name dictionary --
+  get_name_count(): number;
+  get_name(id: number): string;
+  rename_name(id: number, name: string): boolean;
+  get_name_pool_ptr(): number;
+  get_name_pool_length(): number;
+  get_name_offsets_ptr(): number;
+  export_player_name_ids(out_ptr: number): number;
+
+  // -- Fuzzy search (results: player index, or team index | 0x80000000) --
+  search(query: string, out_ptr: number, max_results: number): number;
+
+  // -- Snapshots (copy-on-write what-if branches) --
+  create_snapshot(name: string): void;
+  restore_snapshot(name: string): boolean;
+  delete_snapshot(name: string): boolean;
+  has_snapshot(name: string): boolean;
+  get_snapshot_count(): number;
+  get_snapshot_memory(): number;
+
+  // -- Bulk transforms (returns players changed) --
+  apply_transform(transform: WasmRosterTransform): number;
+
+  // -- Overall rating (position-aware formula; auto mode refreshes on every rating write) --
+  recompute_overalls(): number;
+  compute_overall(index: number): number;
+  set_auto_overall(enabled: boolean): void;
+  get_auto_overall(): boolean;
+  set_overall_weight(position: number, rating_id: number, weight: number): void;
+  get_overall_weight(position: number, rating_id: number): number;
+  reset_overall_weights(): void;
+
+  // -- Aggregate statistics (cached, updated incrementally as fields change) --
+  /** Writes 11 x 32-bit per non-empty group: [group, count, mean f32, stddev f32, min, max, p10, p25, p50, p75, p90] */
+  stats_summary(kind: WasmFieldKind, id: number, group_by: WasmStatsGroupBy, out_ptr: number, max_groups: number): number;
+  /** Writes int32 [first value, bin width, ...counts]; returns the bin count (out_ptr 0 = count only) */
+  stats_histogram(kind: WasmFieldKind, id: number, group_by: WasmStatsGroupBy, group: number, out_ptr: number, max_bins: number): number;
+  stats_quantile(kind: WasmFieldKind, id: number, group_by: WasmStatsGroupBy, group: number, q: number): number;
+  /** Leaderboard: writes [player, value] uint32 pairs (read with Uint32Array), best first (k <= 100); returns how many */
+  stats_top(kind: WasmFieldKind, id: number, group_by: WasmStatsGroupBy, group: number, k: number, out_ptr: number): number;
+
+  // -- Change feed --
+  /** Writes [record u16, table u8 (0 player, 1 team), WasmChangeGroup mask u8] entries; returns the count */
+  drain_changes(out_ptr: number, max_changes: number): number;
+  get_pending_change_count(): number;
+
+  // -- Diff & background tasks (handles complete inline in single-threaded builds) --
+  diff_players(other_ptr: number, other_length: number, out_ptr: number, max_results: number): number;
+  /** uint32 per record bit (MSB-first) counting records where it differs; table 0 = players, 1 = teams */
+  diff_bit_heatmap(other_ptr: number, other_length: number, table: number, out_ptr: number): number;
+  /** Writes 16-byte [bit_pos, width, min_records, max_records] uint32 runs, most-changed first; returns the total */
+  diff_bit_runs(other_ptr: number, other_length: number, table: number, min_records: number, out_ptr: number, max_runs: number): number;
+  /** Integrity scan: writes [code, detail, team, player] uint16 quads to out_ptr; returns total issues */
+  validate(out_ptr: number, max_issues: number): number;
+  /** Writes 16-byte [bit_pos u32, width i32, matches i32, mean_error f32] candidates; returns how many qualified */
+  find_field(search: WasmFieldSearch, out_ptr: number, max_results: number): number;
+  /** Writes 8-byte [player i32, distance f32] matches, closest first; returns how many were ranked */
+  find_similar(search: WasmSimilaritySearch, player: number, out_ptr: number, max_results: number): number;
+  /** Solve without writing; returns the number of players the plan changes */
+  plan_balance(balancer: WasmRosterBalancer): number;
+  /** Writes the last plan in one batch; returns players written (0 if the roster changed since) */
+  apply_balance(balancer: WasmRosterBalancer): number;
+  /** Fills free slots with generated free agents; writes their int32 indices to out_ptr (0 = skip); returns how many */
+  generate_players(generator: WasmPlayerGenerator, count: number, out_ptr: number): number;
+  init_async(buffer_ptr: number, buffer_length: number): number;
+  load_prepared_async(): number;
+  checksum_async(): number;
+  export_async(out_ptr: number): number;
+  diff_players_async(other_ptr: number, other_length: number, out_ptr: number, max_results: number): number;
+  plan_balance_async(balancer: WasmRosterBalancer): number;
+  is_task_done(handle: number): boolean;
+  wait_task(handle: number): number;
+
+  // -- Status (RosterStatus: 0 = OK; sticky until clear_status) --
+  get_last_status(): number;
+  get_last_error(): string;
+  clear_status(): void;
+}
+
+/** Several rosters in one module; records are stored once and shared copy-on-write */
+export interface WasmRosterWorkspace {
+  /** Copies the image in (the caller may free it); returns the roster id */
+  add_roster(name: string, buffer_ptr: number, buffer_length: number): number;
+  remove_roster(id: number): boolean;
+  get_roster_count(): number;
+  get_roster_name(id: number): string;
+  get_roster_length(id: number): number;
+  /** Writes the committed bytes to out_ptr; returns the length */
+  export_roster(id: number, out_ptr: number): number;
+  /** Materializes a working copy and inits `editor` on it */
+  checkout(id: number, editor: WasmRosterEditor): boolean;
+  commit(id: number): boolean;
+  release(id: number): boolean;
+  /** Differing player indices (uint32) between two committed rosters; returns the total */
+  diff_players(a: number, b: number, out_ptr: number, max_results: number): number;
+  get_unique_segment_count(): number;
+  get_stored_bytes(): number;
+  get_logical_bytes(): number;
+  delete(): void;
 }
 
 export interface RosterEditorModule {
   RosterEditor: new () => WasmRosterEditor;
   Player: new () => WasmPlayer;
+  RosterTransform: new () => WasmRosterTransform;
+  FieldSearch: new () => WasmFieldSearch;
+  SimilaritySearch: new () => WasmSimilaritySearch;
+  RosterBalancer: new () => WasmRosterBalancer;
+  PlayerGenerator: new () => WasmPlayerGenerator;
+  RosterWorkspace: new () => WasmRosterWorkspace;
 
   // Emscripten runtime
   _malloc(size: number): number;
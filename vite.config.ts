@@ -13,5 +13,10 @@ export default defineConfig({
   },
   server: {
     port: 3051,
+    // Cross-origin isolation, so the pthread Wasm build can use SharedArrayBuffer
+    headers: {
+      "Cross-Origin-Opener-Policy": "same-origin",
+      "Cross-Origin-Embedder-Policy": "require-corp",
+    },
   },
 })
@@ -6,8 +6,9 @@
 // ============================================================================
 
 #include "BitStream.hpp"
-#include <stdexcept>
+#include "RosterStatus.hpp"
 #include <algorithm>
+#include <cstring>
 
 // ---- Construction -----------------------------------------------------------
 
@@ -15,7 +16,8 @@ BitStream::BitStream(uint8_t* buffer, size_t length)
     : buffer_(buffer), length_(length), byte_offset_(0), bit_offset_(0)
 {
     if (!buffer && length > 0) {
-        throw std::invalid_argument("BitStream: null buffer with non-zero length");
+        roster_fail(ROSTER_ERR_INVALID_ARGUMENT, "BitStream: null buffer with non-zero length");
+        length_ = 0;
     }
 }
 
@@ -23,10 +25,12 @@ BitStream::BitStream(uint8_t* buffer, size_t length)
 
 void BitStream::jump_to(size_t byte_offset, int bit_offset) {
     if (byte_offset > length_) {
-        throw std::out_of_range("BitStream::jump_to: byte offset beyond buffer");
+        roster_fail(ROSTER_ERR_OUT_OF_RANGE, "BitStream::jump_to: byte offset beyond buffer");
+        return;
     }
     if (bit_offset < 0 || bit_offset > 7) {
-        throw std::out_of_range("BitStream::jump_to: bit offset must be 0-7");
+        roster_fail(ROSTER_ERR_OUT_OF_RANGE, "BitStream::jump_to: bit offset must be 0-7");
+        return;
     }
     byte_offset_ = byte_offset;
     bit_offset_  = bit_offset;
@@ -38,29 +42,32 @@ void BitStream::move(int bytes, int bits) {
                          + static_cast<long long>(bytes) * 8 + bits;
 
     if (total_bits < 0) {
-        throw std::out_of_range("BitStream::move: resulting position is negative");
+        roster_fail(ROSTER_ERR_OUT_OF_RANGE, "BitStream::move: resulting position is negative");
+        return;
+    }
+    if (static_cast<size_t>(total_bits / 8) > length_) {
+        roster_fail(ROSTER_ERR_OUT_OF_RANGE, "BitStream::move: resulting position beyond buffer");
+        return;
     }
 
     byte_offset_ = static_cast<size_t>(total_bits / 8);
     bit_offset_  = static_cast<int>(total_bits % 8);
-
-    if (byte_offset_ > length_) {
-        throw std::out_of_range("BitStream::move: resulting position beyond buffer");
-    }
 }
 
 // ---- Reading ----------------------------------------------------------------
 
 uint32_t BitStream::read_bits(int count) {
     if (count <= 0 || count > 32) {
-        throw std::invalid_argument("BitStream::read_bits: count must be 1-32");
+        roster_fail(ROSTER_ERR_INVALID_ARGUMENT, "BitStream::read_bits: count must be 1-32");
+        return 0;
     }
 
     uint32_t result = 0;
 
     for (int i = 0; i < count; ++i) {
         if (byte_offset_ >= length_) {
-            throw std::out_of_range("BitStream::read_bits: read past end of buffer");
+            roster_fail(ROSTER_ERR_OUT_OF_RANGE, "BitStream::read_bits: read past end of buffer");
+            return 0;
         }
 
         // Extract single bit (MSB-first within each byte)
@@ -95,12 +102,14 @@ void BitStream::read_bytes(uint8_t* out, int count) {
 
 void BitStream::write_bits(uint32_t value, int count) {
     if (count <= 0 || count > 32) {
-        throw std::invalid_argument("BitStream::write_bits: count must be 1-32");
+        roster_fail(ROSTER_ERR_INVALID_ARGUMENT, "BitStream::write_bits: count must be 1-32");
+        return;
     }
 
     for (int i = count - 1; i >= 0; --i) {
         if (byte_offset_ >= length_) {
-            throw std::out_of_range("BitStream::write_bits: write past end of buffer");
+            roster_fail(ROSTER_ERR_OUT_OF_RANGE, "BitStream::write_bits: write past end of buffer");
+            return;
         }
 
         // Extract the i-th bit from value (MSB-first)
@@ -132,3 +141,63 @@ void BitStream::write_bytes(const uint8_t* data, int count) {
         write_byte(data[i]);
     }
 }
+
+// ---- Block access -----------------------------------------------------------
+// With the run starting `shift` bits into byte p[0], output byte i is
+// (p[i] << shift) | (p[i + 1] >> (8 - shift)). Eight of those at once is one
+// big-endian 64-bit load shifted left, topped up from the following byte.
+// Wasm and x86 are little-endian: one unaligned load plus a byte swap.
+
+static inline uint64_t load_be64(const uint8_t* p) {
+    uint64_t v;
+    std::memcpy(&v, p, 8);
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    v = __builtin_bswap64(v);
+#endif
+    return v;
+}
+
+static inline void store_be64(uint8_t* p, uint64_t v) {
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    v = __builtin_bswap64(v);
+#endif
+    std::memcpy(p, &v, 8);
+}
+
+void BitStream::peek_block(const uint8_t* base, size_t bit_pos, uint8_t* out, size_t nbytes) {
+    const uint8_t* p = base + (bit_pos >> 3);
+    int shift = static_cast<int>(bit_pos & 7);
+    if (shift == 0) {
+        std::memcpy(out, p, nbytes);
+        return;
+    }
+    size_t i = 0;
+    for (; i + 8 <= nbytes; i += 8) {
+        store_be64(out + i, (load_be64(p + i) << shift) | (p[i + 8] >> (8 - shift)));
+    }
+    for (; i < nbytes; ++i) {
+        out[i] = static_cast<uint8_t>((p[i] << shift) | (p[i + 1] >> (8 - shift)));
+    }
+}
+
+void BitStream::poke_block(uint8_t* base, size_t bit_pos, const uint8_t* in, size_t nbytes) {
+    uint8_t* p = base + (bit_pos >> 3);
+    int shift = static_cast<int>(bit_pos & 7);
+    if (shift == 0) {
+        std::memcpy(p, in, nbytes);
+        return;
+    }
+    const uint64_t keep_hi = ~(~uint64_t(0) >> shift);        // Bits before the run
+    const uint8_t  keep_lo = static_cast<uint8_t>(0xFF >> shift);   // Bits after it
+    size_t i = 0;
+    for (; i + 8 <= nbytes; i += 8) {
+        uint64_t v = load_be64(in + i);
+        store_be64(p + i, (load_be64(p + i) & keep_hi) | (v >> shift));
+        p[i + 8] = static_cast<uint8_t>((p[i + 8] & keep_lo) | (v << (8 - shift)));
+    }
+    for (; i < nbytes; ++i) {
+        uint8_t v = in[i];
+        p[i]     = static_cast<uint8_t>((p[i] & ~keep_lo) | (v >> shift));
+        p[i + 1] = static_cast<uint8_t>((p[i + 1] & keep_lo) | (v << (8 - shift)));
+    }
+}
@@ -9,10 +9,14 @@
 // tracking.
 //
 // Design inspired by leftos/nba-2k13-roster-editor NonByteAlignedBinaryRW.
+//
+// The cursor API validates every step. Record accessors whose spans were
+// validated up front use the unchecked peek_bits / poke_bits instead.
 // ============================================================================
 
 #include <cstdint>
 #include <cstddef>
+#include <cstring>
 
 class BitStream {
 public:
@@ -52,9 +56,65 @@ public:
     // Write N aligned bytes from a caller-provided buffer.
     void write_bytes(const uint8_t* data, int count);
 
+    // ---- Unchecked access ---------------------------------------------------
+    // Read / write `count` (1-32) bits starting `bit_pos` bits into `base`,
+    // same MSB-first numbering as the cursor API. No bounds checks: the
+    // caller guarantees the bits lie inside its buffer.
+    static inline uint32_t peek_bits(const uint8_t* base, size_t bit_pos, int count);
+    static inline void     poke_bits(uint8_t* base, size_t bit_pos, int count, uint32_t value);
+
+    // Copy `nbytes` whole bytes out of / into a bit run starting at
+    // `bit_pos`, funnel-shifting 64 bits per step. Touches the bytes
+    // [bit_pos / 8, bit_pos / 8 + nbytes] only (one extra when unaligned);
+    // poke_block preserves the bits around the run. Unchecked, as above.
+    static void peek_block(const uint8_t* base, size_t bit_pos, uint8_t* out, size_t nbytes);
+    static void poke_block(uint8_t* base, size_t bit_pos, const uint8_t* in, size_t nbytes);
+
+    // The bits from `bit_pos` on, MSB-aligned in a 64-bit word: the top 57
+    // are exact, so any field up to 57 bits is window >> (64 - width).
+    // Reads the 8 bytes at bit_pos / 8. Unchecked, as above.
+    static inline uint64_t peek_window(const uint8_t* base, size_t bit_pos);
+
 private:
     uint8_t* buffer_;
     size_t   length_;          // Total buffer size in bytes
     size_t   byte_offset_;     // Current byte position
     int      bit_offset_;      // Current bit position within byte (0–7, MSB=0)
 };
+
+// ---- Unchecked access (inline: these sit on the per-field hot path) ---------
+// The field spans at most 5 bytes; gather exactly those into a 64-bit window.
+
+inline uint32_t BitStream::peek_bits(const uint8_t* base, size_t bit_pos, int count) {
+    const uint8_t* p = base + (bit_pos >> 3);
+    int shift = static_cast<int>(bit_pos & 7);
+    int nbytes = (shift + count + 7) >> 3;
+    uint64_t window = 0;
+    for (int i = 0; i < nbytes; ++i) window = (window << 8) | p[i];
+    window >>= nbytes * 8 - shift - count;
+    return static_cast<uint32_t>(window & ((uint64_t(1) << count) - 1));
+}
+
+inline uint64_t BitStream::peek_window(const uint8_t* base, size_t bit_pos) {
+    uint64_t v;
+    std::memcpy(&v, base + (bit_pos >> 3), 8);
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    v = __builtin_bswap64(v);
+#endif
+    return v << (bit_pos & 7);
+}
+
+inline void BitStream::poke_bits(uint8_t* base, size_t bit_pos, int count, uint32_t value) {
+    uint8_t* p = base + (bit_pos >> 3);
+    int shift = static_cast<int>(bit_pos & 7);
+    int nbytes = (shift + count + 7) >> 3;
+    int low = nbytes * 8 - shift - count;   // Untouched bits after the field
+    uint64_t mask = ((uint64_t(1) << count) - 1) << low;
+    uint64_t window = 0;
+    for (int i = 0; i < nbytes; ++i) window = (window << 8) | p[i];
+    window = (window & ~mask) | ((static_cast<uint64_t>(value) << low) & mask);
+    for (int i = nbytes - 1; i >= 0; --i) {
+        p[i] = static_cast<uint8_t>(window);
+        window >>= 8;
+    }
+}
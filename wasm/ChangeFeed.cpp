@@ -0,0 +1,52 @@
+// ============================================================================
+// ChangeFeed.cpp — Record/field-group dirty set
+// ============================================================================
+
+#include "ChangeFeed.hpp"
+#include <algorithm>
+
+ChangeFeed::ChangeFeed() : pending_(0) {}
+
+void ChangeFeed::reset(int player_count, int team_count) {
+    const int counts[CHANGE_TABLE_COUNT] = { player_count, team_count };
+    for (int t = 0; t < CHANGE_TABLE_COUNT; ++t) {
+        size_t n = static_cast<size_t>(std::max(counts[t], 0));
+        tables_[t].dirty.assign((n + 63) / 64, 0);
+        tables_[t].groups.assign(n, 0);
+    }
+    pending_ = 0;
+}
+
+void ChangeFeed::mark(int table, int record, uint8_t groups) {
+    if (table < 0 || table >= CHANGE_TABLE_COUNT || groups == 0) return;
+    Table& t = tables_[table];
+    if (record < 0 || static_cast<size_t>(record) >= t.groups.size()) return;
+    uint64_t bit = uint64_t(1) << (record & 63);
+    uint64_t& word = t.dirty[record >> 6];
+    if (!(word & bit)) {
+        word |= bit;
+        ++pending_;
+    }
+    t.groups[record] |= groups;
+}
+
+int ChangeFeed::drain(RecordChange* out, int max_changes) {
+    if (!out || max_changes <= 0) return 0;
+    int written = 0;
+    for (int table = 0; table < CHANGE_TABLE_COUNT; ++table) {
+        Table& t = tables_[table];
+        for (size_t w = 0; w < t.dirty.size(); ++w) {
+            uint64_t bits = t.dirty[w];
+            while (bits) {
+                if (written == max_changes) return written;
+                int record = static_cast<int>(w * 64) + __builtin_ctzll(bits);
+                out[written++] = { static_cast<uint16_t>(record), static_cast<uint8_t>(table), t.groups[record] };
+                t.groups[record] = 0;
+                bits &= bits - 1;
+                t.dirty[w] = bits;   // Cleared as drained, so a short drain resumes here
+                --pending_;
+            }
+        }
+    }
+    return written;
+}
@@ -0,0 +1,66 @@
+#pragma once
+// ============================================================================
+// ChangeFeed.hpp — Which records changed since the frontend last looked
+// ============================================================================
+//
+// A two-level dirty set over the player and team tables: one bit per record,
+// and for each marked record a mask of the field groups that were written.
+// The editor's write barrier feeds it, so every setter, transform and record
+// operation is covered without per-setter bookkeeping. drain() hands the
+// pending (record, groups) entries to JS and clears them, letting the UI
+// re-read only the rows and panels that changed.
+//
+// Groups are derived from byte ranges, so a write to a byte shared by two
+// packed fields marks both groups (a superset, never a miss).
+// ============================================================================
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+enum ChangeGroup {
+    CHANGE_RATINGS    = 1 << 0,
+    CHANGE_TENDENCIES = 1 << 1,   // Tendencies, hot zones, signature skills
+    CHANGE_VITALS     = 1 << 2,   // Also player bytes no known field covers
+    CHANGE_GEAR       = 1 << 3,
+    CHANGE_ANIMATIONS = 1 << 4,
+    CHANGE_IDENTITY   = 1 << 5,   // Player CFID / name IDs; team id, strings, colors
+    CHANGE_ROSTER     = 1 << 6,   // Team roster slots
+    CHANGE_ALL        = 0x7F
+};
+
+enum ChangeTable {
+    CHANGE_TABLE_PLAYER = 0,
+    CHANGE_TABLE_TEAM,
+    CHANGE_TABLE_COUNT
+};
+
+// Packed 4-byte entry for JS typed-array reads.
+struct RecordChange {
+    uint16_t record;
+    uint8_t  table;    // ChangeTable
+    uint8_t  groups;   // ChangeGroup mask
+};
+
+class ChangeFeed {
+public:
+    ChangeFeed();
+
+    // Size for a freshly attached buffer; nothing is pending afterwards.
+    void reset(int player_count, int team_count);
+
+    void mark(int table, int record, uint8_t groups);
+    int  pending() const { return pending_; }
+
+    // Write up to max_changes entries (players ascending, then teams) to out
+    // and clear them; anything past max_changes stays pending.
+    int  drain(RecordChange* out, int max_changes);
+
+private:
+    struct Table {
+        std::vector<uint64_t> dirty;    // Level 1: one bit per record
+        std::vector<uint8_t>  groups;   // Level 2: ChangeGroup mask per record
+    };
+    Table tables_[CHANGE_TABLE_COUNT];
+    int   pending_;
+};
@@ -0,0 +1,171 @@
+// ============================================================================
+// FieldSearch.cpp — Brute-force field location over the player table
+// ============================================================================
+
+#include "FieldSearch.hpp"
+#include "BitStream.hpp"
+#include "RosterStatus.hpp"
+#include "TaskScheduler.hpp"
+#include <algorithm>
+#include <cstring>
+
+FieldSearch::FieldSearch()
+    : transform_(SEARCH_RAW), min_width_(1), max_width_(16),
+      tolerance_(0), first_byte_(0), last_byte_(-1), min_matches_(0)
+{}
+
+void FieldSearch::add(int player, int value) {
+    if (static_cast<int>(observations_.size()) >= MAX_OBSERVATIONS) {
+        roster_fail(ROSTER_ERR_INVALID_ARGUMENT, "FieldSearch::add: too many observations");
+        return;
+    }
+    observations_.push_back({ player, value });
+}
+
+void FieldSearch::clear() {
+    observations_.clear();
+}
+
+void FieldSearch::set_transform(int transform) {
+    if (transform < 0 || transform >= SEARCH_TRANSFORM_COUNT) {
+        roster_fail(ROSTER_ERR_INVALID_ARGUMENT, "FieldSearch::set_transform: unknown transform");
+        return;
+    }
+    transform_ = transform;
+}
+
+void FieldSearch::set_widths(int min_width, int max_width) {
+    if (min_width < 1 || max_width > MAX_WIDTH || min_width > max_width) {
+        roster_fail(ROSTER_ERR_INVALID_ARGUMENT, "FieldSearch::set_widths: widths must be 1–32");
+        return;
+    }
+    min_width_ = min_width;
+    max_width_ = max_width;
+}
+
+void FieldSearch::set_tolerance(int tolerance) {
+    tolerance_ = std::max(tolerance, 0);
+}
+
+void FieldSearch::set_byte_range(int first, int last) {
+    if (first < 0 || (last >= 0 && last < first)) {
+        roster_fail(ROSTER_ERR_INVALID_ARGUMENT, "FieldSearch::set_byte_range: bad range");
+        return;
+    }
+    first_byte_ = first;
+    last_byte_  = last;
+}
+
+void FieldSearch::set_min_matches(int n) {
+    min_matches_ = std::max(n, 0);
+}
+
+// ============================================================================
+// Search
+// ============================================================================
+
+template <int Transform>
+static inline int64_t transformed(uint64_t raw) {
+    if constexpr (Transform == SEARCH_RATING) return static_cast<int64_t>(raw / 3) + 25;
+    if constexpr (Transform == SEARCH_MASK7)  return static_cast<int64_t>(raw & 0x7F);
+    return static_cast<int64_t>(raw);
+}
+
+// Add one observation's hits for bit positions [begin, end) into the
+// per-(position, width) tallies.
+template <int Transform>
+static void tally(const uint8_t* rec, size_t first_bit, size_t begin, size_t end,
+                  int min_width, int widths, int64_t expected, int64_t tolerance,
+                  uint16_t* matches, float* error) {
+    for (size_t i = begin; i < end; ++i) {
+        uint64_t window = BitStream::peek_window(rec, first_bit + i);
+        uint16_t* m = matches + i * widths;
+        float*    e = error + i * widths;
+        for (int k = 0; k < widths; ++k) {
+            int64_t v = transformed<Transform>(window >> (64 - (min_width + k)));
+            int64_t d = v > expected ? v - expected : expected - v;
+            bool hit = d <= tolerance;
+            m[k] += hit;
+            e[k] += hit ? static_cast<float>(d) : 0.0f;
+        }
+    }
+}
+
+int FieldSearch::run(const uint8_t* table, size_t record_size, int player_count,
+                     Candidate* out, int max_results) const {
+    if (observations_.empty()) {
+        roster_fail(ROSTER_ERR_INVALID_ARGUMENT, "FieldSearch::run: no observations");
+        return 0;
+    }
+    for (const Observation& o : observations_) {
+        if (o.player < 0 || o.player >= player_count) {
+            roster_fail(ROSTER_ERR_OUT_OF_RANGE, "FieldSearch::run: player index out of range");
+            return 0;
+        }
+    }
+
+    const size_t record_bits = record_size * 8;
+    const size_t first_bit = static_cast<size_t>(first_byte_) * 8;
+    const size_t end_bit = last_byte_ < 0 ? record_bits
+                         : std::min(record_bits, (static_cast<size_t>(last_byte_) + 1) * 8);
+    if (first_bit >= end_bit) return 0;
+    const size_t positions = end_bit - first_bit;
+    const int    widths = max_width_ - min_width_ + 1;
+
+    // Private padded copies: peek_window reads 8 bytes from any position.
+    const size_t stride = record_size + 8;
+    std::vector<uint8_t> records(observations_.size() * stride, 0);
+    for (size_t o = 0; o < observations_.size(); ++o) {
+        std::memcpy(&records[o * stride], table + static_cast<size_t>(observations_[o].player) * record_size,
+                    record_size);
+    }
+
+    std::vector<uint16_t> matches(positions * widths, 0);
+    std::vector<float>    error(positions * widths, 0.0f);
+    TaskScheduler::shared().parallel_for(positions, 256, [&](size_t begin, size_t end) {
+        for (size_t o = 0; o < observations_.size(); ++o) {
+            const uint8_t* rec = &records[o * stride];
+            int64_t expected = observations_[o].value;
+            switch (transform_) {
+                case SEARCH_RATING:
+                    tally<SEARCH_RATING>(rec, first_bit, begin, end, min_width_, widths, expected, tolerance_,
+                                         matches.data(), error.data());
+                    break;
+                case SEARCH_MASK7:
+                    tally<SEARCH_MASK7>(rec, first_bit, begin, end, min_width_, widths, expected, tolerance_,
+                                        matches.data(), error.data());
+                    break;
+                default:
+                    tally<SEARCH_RAW>(rec, first_bit, begin, end, min_width_, widths, expected, tolerance_,
+                                      matches.data(), error.data());
+                    break;
+            }
+        }
+    });
+
+    const int needed = min_matches_ == 0 ? get_observation_count()
+                     : std::min(min_matches_, get_observation_count());
+    std::vector<Candidate> found;
+    for (size_t i = 0; i < positions; ++i) {
+        for (int k = 0; k < widths; ++k) {
+            int width = min_width_ + k;
+            int hits = matches[i * widths + k];
+            if (hits < needed || first_bit + i + width > record_bits) continue;
+            found.push_back({ static_cast<uint32_t>(first_bit + i), width, hits,
+                              error[i * widths + k] / static_cast<float>(std::max(hits, 1)) });
+        }
+    }
+
+    if (out && max_results > 0) {
+        auto better = [](const Candidate& a, const Candidate& b) {
+            if (a.matches != b.matches)       return a.matches > b.matches;
+            if (a.mean_error != b.mean_error) return a.mean_error < b.mean_error;
+            if (a.width != b.width)           return a.width < b.width;
+            return a.bit_pos < b.bit_pos;
+        };
+        size_t n = std::min(found.size(), static_cast<size_t>(max_results));
+        std::partial_sort(found.begin(), found.begin() + n, found.end(), better);
+        std::copy(found.begin(), found.begin() + n, out);
+    }
+    return static_cast<int>(found.size());
+}
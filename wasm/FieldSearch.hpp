@@ -0,0 +1,81 @@
+#pragma once
+// ============================================================================
+// FieldSearch.hpp — Locate an unknown player field from known values
+// ============================================================================
+//
+// The native replacement for the find_*.cjs brute-force scripts. Give it a
+// few (player, expected value) observations and a transform, and it scores
+// every (bit position, width) in the player record by how many observations
+// the bits there reproduce:
+//
+//     FieldSearch s;
+//     s.set_transform(SEARCH_RATING);   // raw / 3 + 25
+//     s.add(16, 99);                    // Player 16's known value
+//     s.add(376, 45);
+//     editor.find_field(s, out_ptr, 20);
+//
+// Each record is read through BitStream::peek_window once per bit position;
+// every candidate width is then one shift of that window. Bit positions are
+// split across the TaskScheduler workers, and the per-width compare and
+// accumulate is a branch-free loop the compiler vectorizes.
+//
+// Ties are broken towards the narrowest width: a value below 128 matches
+// both an 8-bit field and the 7 bits after its top bit, and the narrower one
+// is the smallest field that explains the data.
+// ============================================================================
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+enum SearchTransform {
+    SEARCH_RAW = 0,     // Bits as stored
+    SEARCH_RATING,      // raw / 3 + 25 (rating display units)
+    SEARCH_MASK7,       // Low 7 bits (a tendency under its category flag)
+    SEARCH_TRANSFORM_COUNT
+};
+
+class FieldSearch {
+public:
+    static constexpr int MAX_WIDTH        = 32;
+    static constexpr int MAX_OBSERVATIONS = 4096;
+
+    // Packed result record, 16 bytes, for JS typed-array reads.
+    struct Candidate {
+        uint32_t bit_pos;      // MSB-first from the record start (byte = bit_pos / 8)
+        int32_t  width;
+        int32_t  matches;      // Observations reproduced within the tolerance
+        float    mean_error;   // Mean |value - expected| over those matches
+    };
+
+    FieldSearch();
+
+    // -- Observations --------------------------------------------------------
+    void add(int player, int value);
+    void clear();
+    int  get_observation_count() const { return static_cast<int>(observations_.size()); }
+
+    // -- Options (bad values report ROSTER_ERR_INVALID_ARGUMENT) -------------
+    void set_transform(int transform);                // SearchTransform, default RAW
+    void set_widths(int min_width, int max_width);    // 1..MAX_WIDTH, default 1..16
+    void set_tolerance(int tolerance);                // Default 0 (exact)
+    void set_byte_range(int first, int last);         // Inclusive; -1 = record end
+    void set_min_matches(int n);                      // 0 (default) = every observation
+
+    // Score every candidate over a player table. Writes the best max_results
+    // to out (which may be null) and returns how many reached min_matches.
+    int run(const uint8_t* table, size_t record_size, int player_count,
+            Candidate* out, int max_results) const;
+
+private:
+    struct Observation {
+        int     player;
+        int64_t value;
+    };
+    std::vector<Observation> observations_;
+    int transform_;
+    int min_width_, max_width_;
+    int tolerance_;
+    int first_byte_, last_byte_;
+    int min_matches_;
+};
@@ -0,0 +1,173 @@
+// ============================================================================
+// MappedFile.cpp — mmap-backed .ROS access (native builds only)
+// ============================================================================
+
+#include "MappedFile.hpp"
+#include "RosterStatus.hpp"
+
+#if ROSTER_HAS_MMAP
+
+#include <algorithm>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <zlib.h>
+
+static inline bool test_bit(const std::vector<uint64_t>& bits, size_t i) {
+    return (bits[i >> 6] >> (i & 63)) & 1u;
+}
+
+static inline void set_bit(std::vector<uint64_t>& bits, size_t i) {
+    bits[i >> 6] |= uint64_t(1) << (i & 63);
+}
+
+MappedFile::MappedFile()
+    : data_(nullptr), length_(0), fd_(-1), mode_(FILE_READ_ONLY),
+      page_size_(4096), crc_(0)
+{}
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+// ============================================================================
+// Open / close
+// ============================================================================
+
+bool MappedFile::open(const std::string& path, FileMode mode) {
+    close();
+
+    int fd = ::open(path.c_str(), mode == FILE_READ_WRITE ? O_RDWR : O_RDONLY);
+    if (fd < 0) {
+        roster_fail(ROSTER_ERR_IO, "MappedFile::open: cannot open " + path);
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < 16) {
+        ::close(fd);
+        roster_fail(ROSTER_ERR_IO, "MappedFile::open: not a roster file: " + path);
+        return false;
+    }
+
+    // Read-only opens still map writable pages (MAP_PRIVATE) so the editor
+    // can patch values in memory; nothing reaches the file.
+    int flags = mode == FILE_READ_WRITE ? MAP_SHARED : MAP_PRIVATE;
+    void* addr = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ | PROT_WRITE, flags, fd, 0);
+    if (addr == MAP_FAILED) {
+        ::close(fd);
+        roster_fail(ROSTER_ERR_IO, "MappedFile::open: mmap failed for " + path);
+        return false;
+    }
+
+    data_      = static_cast<uint8_t*>(addr);
+    length_    = static_cast<size_t>(st.st_size);
+    fd_        = fd;
+    mode_      = mode;
+    long ps    = sysconf(_SC_PAGESIZE);
+    page_size_ = ps > 0 ? static_cast<size_t>(ps) : 4096;
+
+    size_t words = (page_count() + 63) / 64;
+    sync_dirty_.assign(words, 0);
+    crc_dirty_.assign(words, 0);
+    page_crc_.assign(page_count(), 0);
+    // The header holds the payload CRC big-endian.
+    crc_ = (uint32_t(data_[0]) << 24) | (uint32_t(data_[1]) << 16) |
+           (uint32_t(data_[2]) << 8)  |  uint32_t(data_[3]);
+    return true;
+}
+
+void MappedFile::close() {
+    if (data_) munmap(data_, length_);
+    if (fd_ >= 0) ::close(fd_);
+    data_   = nullptr;
+    length_ = 0;
+    fd_     = -1;
+    sync_dirty_.clear();
+    crc_dirty_.clear();
+    page_crc_.clear();
+    crc_ = 0;
+}
+
+void MappedFile::advise_sequential(bool sequential) {
+    if (data_) madvise(data_, length_, sequential ? MADV_SEQUENTIAL : MADV_RANDOM);
+}
+
+// ============================================================================
+// Dirty tracking
+// ============================================================================
+
+void MappedFile::mark_dirty(size_t offset, size_t length) {
+    if (!data_ || length == 0 || offset >= length_) return;
+    size_t last = std::min(offset + length, length_) - 1;
+    // The 4-byte header is not part of the checksum payload, so a write that
+    // stays inside it (the checksum itself) leaves the page CRCs valid.
+    bool payload = last >= 4;
+    for (size_t page = offset / page_size_; page <= last / page_size_; ++page) {
+        set_bit(sync_dirty_, page);
+        if (!payload || test_bit(crc_dirty_, page)) continue;
+        page_crc_[page] = page_payload_crc(page, nullptr);
+        set_bit(crc_dirty_, page);
+    }
+}
+
+// ============================================================================
+// Checksum — incremental updates from per-page CRC changes
+// ============================================================================
+// Page 0 contributes bytes [4, page_size); the 4-byte header is excluded,
+// and mark_dirty() does not hash page 0 for writes confined to it.
+//
+// crc32_combine(a, b, n) is linear in a, so for a payload P‖X‖S in which only
+// X changes, crc(P‖X'‖S) = crc(P‖X‖S) ^ crc32_combine(crc(X) ^ crc(X'), 0, |S|).
+// Each dirty page costs two hashes of that page (before the first write,
+// and here) and nothing is read for the rest of the file.
+
+uint32_t MappedFile::page_payload_crc(size_t page, size_t* tail) const {
+    size_t lo = std::max<size_t>(page * page_size_, 4);
+    size_t hi = std::min(length_, (page + 1) * page_size_);
+    if (tail) *tail = length_ - hi;
+    uLong c = crc32(0L, Z_NULL, 0);
+    return static_cast<uint32_t>(crc32(c, data_ + lo, static_cast<uInt>(hi - lo)));
+}
+
+uint32_t MappedFile::payload_crc() {
+    uLong crc = crc_;
+    for (size_t w = 0; w < crc_dirty_.size(); ++w) {
+        for (uint64_t bits = crc_dirty_[w]; bits; bits &= bits - 1) {
+            size_t page = w * 64 + static_cast<size_t>(__builtin_ctzll(bits));
+            size_t tail = 0;
+            uint32_t delta = page_crc_[page] ^ page_payload_crc(page, &tail);
+            crc ^= crc32_combine(delta, 0, static_cast<z_off_t>(tail));
+        }
+    }
+    std::fill(crc_dirty_.begin(), crc_dirty_.end(), 0);
+    crc_ = static_cast<uint32_t>(crc);
+    return crc_;
+}
+
+// ============================================================================
+// Flush
+// ============================================================================
+
+bool MappedFile::sync() {
+    if (!data_ || mode_ != FILE_READ_WRITE) return true;
+    const size_t pages = page_count();
+    size_t page = 0;
+    while (page < pages) {
+        if (!test_bit(sync_dirty_, page)) { ++page; continue; }
+        size_t run = page;
+        while (run < pages && test_bit(sync_dirty_, run)) ++run;
+        size_t lo = page * page_size_;
+        size_t hi = std::min(length_, run * page_size_);
+        if (msync(data_ + lo, hi - lo, MS_SYNC) != 0) {
+            roster_fail(ROSTER_ERR_IO, "MappedFile::sync: msync failed");
+            return false;
+        }
+        page = run;
+    }
+    std::fill(sync_dirty_.begin(), sync_dirty_.end(), 0);
+    return true;
+}
+
+#endif // ROSTER_HAS_MMAP
@@ -0,0 +1,84 @@
+#pragma once
+// ============================================================================
+// MappedFile.hpp — mmap-backed .ROS access for native (non-Wasm) builds
+// ============================================================================
+//
+// Maps a roster file so RosterEditor can run discovery and edits directly on
+// the page cache instead of reading the whole file into memory. Writes are
+// tracked per page; on save only dirty pages are re-hashed and msync'd. The
+// checksum starts from the one stored in the file and is updated by each
+// dirty page's CRC change, so no save has to read the whole file.
+//
+// Only available where POSIX mmap exists — ROSTER_HAS_MMAP is 0 in the
+// Emscripten and Windows builds and the class compiles to nothing.
+// ============================================================================
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#if !defined(__EMSCRIPTEN__) && !defined(_WIN32)
+#define ROSTER_HAS_MMAP 1
+#else
+#define ROSTER_HAS_MMAP 0
+#endif
+
+enum FileMode {
+    FILE_READ_ONLY = 0,   // Private mapping: edits stay in memory, never saved
+    FILE_READ_WRITE       // Shared mapping: save() writes dirty pages back
+};
+
+#if ROSTER_HAS_MMAP
+
+class MappedFile {
+public:
+    MappedFile();
+    ~MappedFile();
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // Reports ROSTER_ERR_IO (see RosterStatus.hpp) and returns false if the
+    // file cannot be opened or mapped.
+    bool open(const std::string& path, FileMode mode);
+    void close();
+
+    bool     is_open() const { return data_ != nullptr; }
+    uint8_t* data()    const { return data_; }
+    size_t   length()  const { return length_; }
+    FileMode mode()    const { return mode_; }
+
+    // Must be called BEFORE bytes [offset, offset + length) are modified:
+    // the first write to a page since the last payload_crc() hashes its old
+    // content.
+    void mark_dirty(size_t offset, size_t length);
+
+    // CRC32 of bytes [4, length) — the .ROS checksum payload. Starts from the
+    // CRC stored in the header at open and only re-hashes pages marked dirty
+    // since the last call; a file whose stored checksum is already wrong
+    // stays wrong.
+    uint32_t payload_crc();
+
+    // msync every dirty page range, then clear the dirty set.
+    bool sync();
+
+    // Hint the kernel about the access pattern (sequential for discovery).
+    void advise_sequential(bool sequential);
+
+private:
+    uint8_t* data_;
+    size_t   length_;
+    int      fd_;
+    FileMode mode_;
+    size_t   page_size_;
+
+    std::vector<uint64_t> sync_dirty_;   // Pages to msync
+    std::vector<uint64_t> crc_dirty_;    // Pages written since the last payload_crc()
+    std::vector<uint32_t> page_crc_;     // Pre-write CRC of each page in crc_dirty_
+    uint32_t              crc_;          // Payload CRC at open / the last payload_crc()
+
+    size_t   page_count() const { return (length_ + page_size_ - 1) / page_size_; }
+    uint32_t page_payload_crc(size_t page, size_t* tail) const;
+};
+
+#endif // ROSTER_HAS_MMAP
@@ -0,0 +1,338 @@
+// ============================================================================
+// NameTable.cpp — Interned name dictionary implementation
+// ============================================================================
+// Table layout (reverse-engineered, see generate_names_ts.cjs):
+//   - Null-terminated UTF-16 LE strings, back to back
+//   - Occasional extra 0x0000 units between strings (padding)
+//   - The N-th non-empty string is name ID N
+// Only printable Latin-1 is accepted, which is also what the game writes.
+// ============================================================================
+
+#include "NameTable.hpp"
+#include <algorithm>
+
+// A run must contain at least this many strings to count as the name table.
+static constexpr int    MIN_TABLE_STRINGS = 256;
+// Longest single name accepted during discovery (in UTF-16 units).
+static constexpr size_t MAX_NAME_UNITS    = 64;
+// More consecutive 0x0000 units than this ends the table.
+static constexpr int    MAX_PADDING_UNITS = 8;
+
+static inline uint16_t load_u16_le(const uint8_t* p) {
+    return static_cast<uint16_t>(p[0]) | (static_cast<uint16_t>(p[1]) << 8);
+}
+
+static inline bool is_name_unit(uint16_t u) {
+    return (u >= 0x20 && u < 0x7F) || (u >= 0xA0 && u <= 0xFF);
+}
+
+// Decode UTF-8 into printable Latin-1 code units. Anything the table cannot
+// hold is replaced with '?', so every accepted name round-trips exactly.
+static std::u16string to_units(std::string_view utf8) {
+    std::u16string out;
+    out.reserve(utf8.size());
+    for (size_t i = 0; i < utf8.size();) {
+        uint8_t c = static_cast<uint8_t>(utf8[i]);
+        uint32_t cp;
+        int extra;
+        if      (c < 0x80)           { cp = c;        extra = 0; }
+        else if ((c & 0xE0) == 0xC0) { cp = c & 0x1F; extra = 1; }
+        else if ((c & 0xF0) == 0xE0) { cp = c & 0x0F; extra = 2; }
+        else if ((c & 0xF8) == 0xF0) { cp = c & 0x07; extra = 3; }
+        else                         { cp = '?';      extra = 0; }
+        ++i;
+        for (int k = 0; k < extra && i < utf8.size(); ++k, ++i) {
+            cp = (cp << 6) | (static_cast<uint8_t>(utf8[i]) & 0x3F);
+        }
+        out.push_back(is_name_unit(static_cast<uint16_t>(cp <= 0xFFFF ? cp : 0))
+                      ? static_cast<char16_t>(cp) : u'?');
+    }
+    return out;
+}
+
+// Latin-1 → UTF-8. Returns the number of bytes written (at most 2 per unit).
+static size_t encode_utf8(const char16_t* units, size_t count, char* out) {
+    size_t n = 0;
+    for (size_t i = 0; i < count; ++i) {
+        uint16_t u = units[i];
+        if (u < 0x80) {
+            out[n++] = static_cast<char>(u);
+        } else {
+            out[n++] = static_cast<char>(0xC0 | (u >> 6));
+            out[n++] = static_cast<char>(0x80 | (u & 0x3F));
+        }
+    }
+    return n;
+}
+
+// ============================================================================
+// Construction / discovery
+// ============================================================================
+
+NameTable::NameTable()
+    : buffer_(nullptr), buffer_length_(0),
+      table_offset_(0), table_end_(0), table_limit_(0), decoded_count_(0)
+{}
+
+void NameTable::clear() {
+    buffer_ = nullptr;
+    buffer_length_ = 0;
+    table_offset_ = table_end_ = table_limit_ = 0;
+    decoded_count_ = 0;
+    pool_.clear();
+    pool_offsets_.clear();
+    entries_.clear();
+    refs_.clear();
+    lookup_.clear();
+}
+
+// Walk a run of strings starting at `offset`. Returns one past the last NUL
+// terminator of the run and stores the number of strings in `count`.
+size_t NameTable::scan_run(size_t offset, int* count) const {
+    size_t pos = offset, end = offset;
+    int n = 0;
+    while (pos + 1 < buffer_length_) {
+        int pad = 0;
+        while (pos + 1 < buffer_length_ && load_u16_le(buffer_ + pos) == 0 && pad <= MAX_PADDING_UNITS) {
+            pos += 2;
+            ++pad;
+        }
+        if (pad > MAX_PADDING_UNITS) break;
+
+        size_t q = pos, units = 0;
+        while (q + 1 < buffer_length_ && units <= MAX_NAME_UNITS && is_name_unit(load_u16_le(buffer_ + q))) {
+            q += 2;
+            ++units;
+        }
+        if (units == 0 || units > MAX_NAME_UNITS) break;
+        if (q + 1 >= buffer_length_ || load_u16_le(buffer_ + q) != 0) break;
+
+        ++n;
+        pos = end = q + 2;
+    }
+    *count = n;
+    return end;
+}
+
+bool NameTable::load(uint8_t* buffer, size_t buffer_length) {
+    clear();
+    buffer_ = buffer;
+    buffer_length_ = buffer_length;
+    if (!buffer_ || buffer_length_ < 4) return false;
+
+    // Keep the longest run of strings; on success skip past it so the scan
+    // stays linear in the buffer size.
+    size_t best_offset = 0;
+    int best_count = 0;
+    for (size_t offset = 0; offset + 1 < buffer_length_;) {
+        if (!is_name_unit(load_u16_le(buffer_ + offset))) { offset += 2; continue; }
+        int count = 0;
+        size_t end = scan_run(offset, &count);
+        if (count >= MIN_TABLE_STRINGS) {
+            if (count > best_count) {
+                best_count  = count;
+                best_offset = offset;
+            }
+            offset = end;
+        } else {
+            offset += 2;
+        }
+    }
+    if (best_count == 0) {
+        clear();
+        return false;
+    }
+    return decode(best_offset);
+}
+
+bool NameTable::reload() {
+    if (!is_loaded()) return false;
+    uint8_t* buffer = buffer_;
+    size_t buffer_length = buffer_length_, offset = table_offset_;
+    clear();
+    buffer_ = buffer;
+    buffer_length_ = buffer_length;
+    return decode(offset);
+}
+
+bool NameTable::overlaps(size_t offset, size_t length) const {
+    return is_loaded() && offset < table_limit_ && offset + length > table_offset_;
+}
+
+// Decode the table that starts at `offset` into the arena.
+bool NameTable::decode(size_t offset) {
+    int count = 0;
+    size_t end = scan_run(offset, &count);
+    if (count == 0) return false;
+
+    table_offset_ = offset;
+    table_end_    = end;
+    table_limit_  = end;
+    while (table_limit_ + 1 < buffer_length_ && load_u16_le(buffer_ + table_limit_) == 0) {
+        table_limit_ += 2;
+    }
+    // Leave the final zero unit alone: it may terminate whatever follows.
+    if (table_limit_ > table_end_) table_limit_ -= 2;
+
+    // Every arena slot is at most as many bytes as its file slot, and appends
+    // consume file bytes up to table_limit_, so this reservation is final.
+    pool_.reserve(table_limit_ - table_offset_ + 1);
+    entries_.reserve(static_cast<size_t>(count) + 64);
+    pool_offsets_.reserve(entries_.capacity());
+    lookup_.reserve(entries_.capacity());
+
+    std::u16string units;
+    size_t pos = table_offset_;
+    while (pos < table_end_) {
+        while (pos < table_end_ && load_u16_le(buffer_ + pos) == 0) pos += 2;
+        if (pos >= table_end_) break;
+
+        units.clear();
+        size_t q = pos;
+        while (load_u16_le(buffer_ + q) != 0) {
+            units.push_back(static_cast<char16_t>(load_u16_le(buffer_ + q)));
+            q += 2;
+        }
+        q += 2;
+        // The slot extends over any padding up to the next string.
+        size_t next = q;
+        while (next < table_end_ && load_u16_le(buffer_ + next) == 0) next += 2;
+
+        Entry e;
+        e.file_offset = static_cast<uint32_t>(pos);
+        e.slot_units  = static_cast<uint32_t>((next - pos) / 2);
+
+        size_t pool_off = pool_.size();
+        pool_.resize(pool_off + e.slot_units * 2);
+        e.length = static_cast<uint32_t>(encode_utf8(units.data(), units.size(), &pool_[pool_off]));
+        pool_[pool_off + e.length] = '\0';
+
+        uint16_t id = static_cast<uint16_t>(entries_.size());
+        entries_.push_back(e);
+        pool_offsets_.push_back(static_cast<uint32_t>(pool_off));
+        lookup_.emplace(std::string_view(&pool_[pool_off], e.length), id);
+        pos = next;
+    }
+    refs_.assign(entries_.size(), 0);
+    decoded_count_ = static_cast<int>(entries_.size());
+    return true;
+}
+
+// ============================================================================
+// Lookup
+// ============================================================================
+
+std::string_view NameTable::get(int id) const {
+    if (id < 0 || id >= size()) return std::string_view();
+    return std::string_view(&pool_[pool_offsets_[id]], entries_[id].length);
+}
+
+const char* NameTable::c_str(int id) const {
+    if (id < 0 || id >= size()) return "";
+    return &pool_[pool_offsets_[id]];
+}
+
+int NameTable::find(std::string_view name) const {
+    auto it = lookup_.find(name);
+    return it == lookup_.end() ? -1 : static_cast<int>(it->second);
+}
+
+// ============================================================================
+// Reference counting
+// ============================================================================
+
+void NameTable::add_ref(int id) {
+    if (id >= 0 && id < size() && refs_[id] < 0xFFFF) refs_[id]++;
+}
+
+void NameTable::release(int id) {
+    if (id >= 0 && id < size() && refs_[id] > 0) refs_[id]--;
+}
+
+int NameTable::get_ref_count(int id) const {
+    return (id >= 0 && id < size()) ? refs_[id] : 0;
+}
+
+// ============================================================================
+// Rewriting
+// ============================================================================
+
+bool NameTable::fits(int id, std::string_view name) const {
+    return to_units(name).size() + 1 <= entries_[id].slot_units;
+}
+
+// Overwrite the file slot (string + NUL + zero padding) and the arena slot.
+void NameTable::write_entry(int id, std::string_view name) {
+    Entry& e = entries_[id];
+    std::u16string units = to_units(name);
+
+    if (write_hook_) write_hook_(e.file_offset, e.slot_units * 2);
+    uint8_t* dst = buffer_ + e.file_offset;
+    std::fill(dst, dst + e.slot_units * 2, static_cast<uint8_t>(0));
+    for (size_t i = 0; i < units.size(); ++i) {
+        dst[i * 2]     = static_cast<uint8_t>(units[i] & 0xFF);
+        dst[i * 2 + 1] = static_cast<uint8_t>(units[i] >> 8);
+    }
+
+    auto old = lookup_.find(get(id));
+    if (old != lookup_.end() && old->second == id) lookup_.erase(old);
+
+    char* slot = &pool_[pool_offsets_[id]];
+    e.length = static_cast<uint32_t>(encode_utf8(units.data(), units.size(), slot));
+    slot[e.length] = '\0';
+    lookup_.emplace(std::string_view(slot, e.length), static_cast<uint16_t>(id));
+}
+
+int NameTable::append(std::string_view name) {
+    if (entries_.size() >= 0xFFFF) return -1;
+    size_t units = to_units(name).size() + 1;
+    size_t need = units * 2;
+    if (table_end_ + need > table_limit_) return -1;
+
+    Entry e;
+    e.file_offset = static_cast<uint32_t>(table_end_);
+    e.slot_units  = static_cast<uint32_t>(units);
+    e.length      = 0;
+    table_end_   += need;
+
+    size_t pool_off = pool_.size();
+    pool_.resize(pool_off + units * 2);
+
+    int id = static_cast<int>(entries_.size());
+    entries_.push_back(e);
+    pool_offsets_.push_back(static_cast<uint32_t>(pool_off));
+    refs_.push_back(0);
+    write_entry(id, name);
+    return id;
+}
+
+bool NameTable::rename(int id, std::string_view name) {
+    if (id < 0 || id >= size() || !fits(id, name)) return false;
+    write_entry(id, name);
+    return true;
+}
+
+int NameTable::assign(int current_id, std::string_view name) {
+    if (!is_loaded()) return -1;
+
+    int existing = find(name);
+    if (existing >= 0) return existing;
+
+    // In-place rewrites need the entry held by exactly this player (entry 0,
+    // the placeholder "0" string, never qualifies as it is never private).
+    // Entries decoded from the file may also be named by staff records,
+    // which are not reference-counted here — renaming one player must not
+    // rename a coach — so those get a new entry while the free space after
+    // the table lasts, and are only rewritten once it is full.
+    bool sole = current_id > 0 && current_id < size() && refs_[current_id] == 1 && fits(current_id, name);
+    if (sole && current_id >= decoded_count_) {
+        write_entry(current_id, name);
+        return current_id;
+    }
+    int id = append(name);
+    if (id < 0 && sole) {
+        write_entry(current_id, name);
+        return current_id;
+    }
+    return id;
+}
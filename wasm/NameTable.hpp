@@ -0,0 +1,108 @@
+#pragma once
+// ============================================================================
+// NameTable.hpp — Interned name dictionary for NBA 2K14 .ROS files
+// ============================================================================
+//
+// Player records do not store text. The 16-bit values at +63 (first name) and
+// +56 (last name) are IDs into a global table of null-terminated UTF-16 LE
+// strings (0x25ED3C in the stock 2013-14 roster — see generate_names_ts.cjs).
+//
+// NameTable locates that table once, decodes every entry into a single
+// arena of NUL-terminated UTF-8 strings and serves ID → name in O(1) without
+// allocating. Each entry keeps its slot in the file, so renames rewrite the
+// arena and the .ROS bytes together.
+// ============================================================================
+
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+class NameTable {
+public:
+    NameTable();
+
+    // Scan the buffer for the name table and decode it. Returns false (and
+    // leaves the table empty) if no plausible table was found.
+    bool load(uint8_t* buffer, size_t buffer_length);
+    // Re-decode the already located table (after its bytes were replaced).
+    bool reload();
+    void clear();
+
+    // True if [offset, offset + length) touches the table or its free space.
+    bool overlaps(size_t offset, size_t length) const;
+
+    // Called before any file bytes are rewritten (offset, length) — lets the
+    // owner keep snapshots and dirty tracking in step with renames.
+    void set_write_hook(std::function<void(size_t, size_t)> hook) { write_hook_ = std::move(hook); }
+
+    bool is_loaded() const { return !entries_.empty(); }
+    int  size()      const { return static_cast<int>(entries_.size()); }
+
+    // O(1) lookup. Unknown IDs yield an empty view / empty C string.
+    std::string_view get(int id) const;
+    const char*      c_str(int id) const;
+
+    // ID of the first entry whose text equals `name`, or -1.
+    int find(std::string_view name) const;
+
+    // -- Reference counting (players pointing at each entry) -----------------
+    void add_ref(int id);
+    void release(int id);
+    int  get_ref_count(int id) const;
+    void reset_refs() { refs_.assign(entries_.size(), 0); }
+
+    // Resolve `name` for a player currently pointing at `current_id`:
+    //   1. reuse an identical entry,
+    //   2. rewrite the current entry in place if this session appended it
+    //      and no other player uses it,
+    //   3. append into the free space after the table,
+    //   4. once that is full, rewrite the current entry if exactly one player
+    //      uses it. File entries may also be named by (untracked) staff
+    //      records, so they are only rewritten as this last resort.
+    // Returns the ID to store in the record, or -1 if the table is full.
+    // Reference counts are NOT adjusted — callers pair add_ref/release.
+    int assign(int current_id, std::string_view name);
+
+    // Rewrite entry `id` in place (arena + file). Affects every player that
+    // shares the ID. Returns false if the text does not fit the entry's slot.
+    bool rename(int id, std::string_view name);
+
+    // -- Raw arena access (for zero-copy reads from JS) ----------------------
+    size_t get_pool_ptr()      const { return reinterpret_cast<size_t>(pool_.data()); }
+    size_t get_pool_length()   const { return pool_.size(); }
+    size_t get_offsets_ptr()   const { return reinterpret_cast<size_t>(pool_offsets_.data()); }
+    size_t get_table_offset()  const { return table_offset_; }
+
+private:
+    struct Entry {
+        uint32_t file_offset;   // Absolute byte offset of the UTF-16 string
+        uint32_t slot_units;    // UTF-16 units available in the file slot (incl. NUL)
+        uint32_t length;        // UTF-8 byte length in the arena (excl. NUL)
+    };
+
+    uint8_t* buffer_;
+    size_t   buffer_length_;
+    size_t   table_offset_;     // First byte of the table
+    size_t   table_end_;        // One past the last string's NUL terminator
+    size_t   table_limit_;      // End of the zero padding that follows the table
+    int      decoded_count_;    // Entries read from the file; later IDs were appended
+
+    // Arena — reserved once at load so string_views into it stay valid.
+    // Every slot is sized from its file slot, which bounds the total.
+    std::vector<char>     pool_;
+    std::vector<uint32_t> pool_offsets_;   // id → offset into pool_
+    std::vector<Entry>    entries_;
+    std::vector<uint16_t> refs_;
+    std::unordered_map<std::string_view, uint16_t> lookup_;
+    std::function<void(size_t, size_t)> write_hook_;
+
+    size_t scan_run(size_t offset, int* count) const;
+    bool   decode(size_t offset);
+    bool   fits(int id, std::string_view name) const;
+    void   write_entry(int id, std::string_view name);
+    int    append(std::string_view name);
+};
@@ -0,0 +1,124 @@
+// ============================================================================
+// OverallModel.cpp — Default weights and evaluation kernels
+// ============================================================================
+
+#include "OverallModel.hpp"
+#include "RosterEditor.hpp"
+
+struct DefaultWeight {
+    int rating;
+    int weight;
+};
+
+static constexpr DefaultWeight PG_WEIGHTS[] = {
+    { RAT_SHOT_3PT, 3 }, { RAT_SHOT_MEDIUM, 3 }, { RAT_SHOOT_OFF_DRIBBLE, 3 }, { RAT_SHOT_CLOSE, 1 },
+    { RAT_SHOT_FT, 1 }, { RAT_LAYUP, 2 }, { RAT_BALL_HANDLING, 4 }, { RAT_OFF_HAND_DRIBBLE, 2 },
+    { RAT_BALL_SECURITY, 2 }, { RAT_PASS, 4 }, { RAT_HANDS, 1 }, { RAT_STEAL, 2 },
+    { RAT_ON_BALL_DEF, 2 }, { RAT_OFF_AWARENESS, 3 }, { RAT_DEF_AWARENESS, 1 }, { RAT_CONSISTENCY, 1 },
+    { RAT_STAMINA, 1 }, { RAT_SPEED, 3 }, { RAT_QUICKNESS, 3 },
+};
+
+static constexpr DefaultWeight SG_WEIGHTS[] = {
+    { RAT_SHOT_3PT, 4 }, { RAT_SHOT_MEDIUM, 4 }, { RAT_SHOOT_OFF_DRIBBLE, 3 }, { RAT_SHOT_CLOSE, 1 },
+    { RAT_SHOT_FT, 1 }, { RAT_LAYUP, 2 }, { RAT_DUNK, 1 }, { RAT_BALL_HANDLING, 2 },
+    { RAT_PASS, 1 }, { RAT_STEAL, 2 }, { RAT_ON_BALL_DEF, 2 }, { RAT_OFF_AWARENESS, 3 },
+    { RAT_DEF_AWARENESS, 1 }, { RAT_CONSISTENCY, 1 }, { RAT_STAMINA, 1 }, { RAT_SPEED, 2 },
+    { RAT_QUICKNESS, 2 }, { RAT_VERTICAL, 1 },
+};
+
+static constexpr DefaultWeight SF_WEIGHTS[] = {
+    { RAT_SHOT_3PT, 2 }, { RAT_SHOT_MEDIUM, 3 }, { RAT_SHOT_CLOSE, 2 }, { RAT_LAYUP, 2 },
+    { RAT_DUNK, 2 }, { RAT_SHOOT_IN_TRAFFIC, 1 }, { RAT_BALL_HANDLING, 1 }, { RAT_PASS, 1 },
+    { RAT_HANDS, 1 }, { RAT_STEAL, 1 }, { RAT_ON_BALL_DEF, 2 }, { RAT_DEF_REBOUND, 1 },
+    { RAT_OFF_AWARENESS, 3 }, { RAT_DEF_AWARENESS, 2 }, { RAT_CONSISTENCY, 1 }, { RAT_SPEED, 2 },
+    { RAT_QUICKNESS, 2 }, { RAT_STRENGTH, 1 }, { RAT_VERTICAL, 2 },
+};
+
+static constexpr DefaultWeight PF_WEIGHTS[] = {
+    { RAT_SHOT_MEDIUM, 2 }, { RAT_SHOT_CLOSE, 3 }, { RAT_SHOT_LOW_POST, 2 }, { RAT_POST_FADEAWAY, 1 },
+    { RAT_POST_HOOK, 1 }, { RAT_DUNK, 1 }, { RAT_STANDING_DUNK, 2 }, { RAT_HANDS, 1 },
+    { RAT_BLOCK, 2 }, { RAT_OFF_REBOUND, 2 }, { RAT_DEF_REBOUND, 3 }, { RAT_OFF_LOW_POST, 2 },
+    { RAT_DEF_LOW_POST, 2 }, { RAT_OFF_AWARENESS, 2 }, { RAT_DEF_AWARENESS, 3 }, { RAT_CONSISTENCY, 1 },
+    { RAT_STRENGTH, 2 }, { RAT_VERTICAL, 1 },
+};
+
+static constexpr DefaultWeight C_WEIGHTS[] = {
+    { RAT_SHOT_CLOSE, 3 }, { RAT_SHOT_LOW_POST, 2 }, { RAT_SHOT_FT, 1 }, { RAT_POST_HOOK, 2 },
+    { RAT_STANDING_DUNK, 3 }, { RAT_STANDING_LAYUP, 1 }, { RAT_HANDS, 1 }, { RAT_BLOCK, 4 },
+    { RAT_OFF_REBOUND, 3 }, { RAT_DEF_REBOUND, 4 }, { RAT_OFF_LOW_POST, 3 }, { RAT_DEF_LOW_POST, 3 },
+    { RAT_OFF_AWARENESS, 2 }, { RAT_DEF_AWARENESS, 3 }, { RAT_CONSISTENCY, 1 }, { RAT_STRENGTH, 3 },
+};
+
+static_assert(OverallModel::RATING_COUNT == RAT_COUNT, "OverallModel::RATING_COUNT out of sync");
+
+OverallModel::OverallModel() {
+    reset_defaults();
+}
+
+void OverallModel::reset_defaults() {
+    struct Table { const DefaultWeight* w; size_t n; };
+    const Table tables[POSITION_COUNT] = {
+        { PG_WEIGHTS, sizeof(PG_WEIGHTS) / sizeof(PG_WEIGHTS[0]) },
+        { SG_WEIGHTS, sizeof(SG_WEIGHTS) / sizeof(SG_WEIGHTS[0]) },
+        { SF_WEIGHTS, sizeof(SF_WEIGHTS) / sizeof(SF_WEIGHTS[0]) },
+        { PF_WEIGHTS, sizeof(PF_WEIGHTS) / sizeof(PF_WEIGHTS[0]) },
+        { C_WEIGHTS,  sizeof(C_WEIGHTS)  / sizeof(C_WEIGHTS[0])  },
+    };
+    for (int row = 0; row < POSITION_COUNT; ++row) {
+        for (int id = 0; id < RATING_COUNT; ++id) weights_[row][id] = 0.0f;
+        for (size_t i = 0; i < tables[row].n; ++i) {
+            weights_[row][tables[row].w[i].rating] = static_cast<float>(tables[row].w[i].weight);
+        }
+        normalize(row);
+    }
+    rebuild_generic();
+}
+
+void OverallModel::set_weight(int position, int rating_id, double weight) {
+    // The overall itself can never feed back into the formula.
+    if (position < 0 || position >= POSITION_COUNT) return;
+    if (rating_id <= RAT_OVERALL || rating_id >= RATING_COUNT || weight < 0) return;
+    weights_[position][rating_id] = static_cast<float>(weight);
+    normalize(position);
+    rebuild_generic();
+}
+
+double OverallModel::get_weight(int position, int rating_id) const {
+    if (position < 0 || position >= ROW_COUNT || rating_id < 0 || rating_id >= RATING_COUNT) return 0.0;
+    return weights_[position][rating_id];
+}
+
+void OverallModel::normalize(int row) {
+    float sum = 0.0f;
+    for (int id = 0; id < RATING_COUNT; ++id) sum += weights_[row][id];
+    for (int id = 0; id < RATING_COUNT; ++id) {
+        normalized_[row][id] = sum > 0.0f ? weights_[row][id] / sum : 0.0f;
+    }
+}
+
+void OverallModel::rebuild_generic() {
+    for (int id = 0; id < RATING_COUNT; ++id) {
+        float sum = 0.0f;
+        for (int row = 0; row < POSITION_COUNT; ++row) sum += normalized_[row][id];
+        weights_[GENERIC_ROW][id] = sum / POSITION_COUNT;
+    }
+    normalize(GENERIC_ROW);
+}
+
+float OverallModel::evaluate(const float* ratings, int row) const {
+    const float* w = normalized_[row];
+    float acc = 0.0f;
+    for (int id = 1; id < RATING_COUNT; ++id) acc += w[id] * ratings[id];
+    return acc;
+}
+
+void OverallModel::evaluate_batch(const float* const* columns, size_t n, int row, float* out) const {
+    const float* w = normalized_[row];
+    for (size_t i = 0; i < n; ++i) out[i] = 0.0f;
+    for (int id = 1; id < RATING_COUNT; ++id) {
+        const float wk = w[id];
+        if (wk == 0.0f) continue;
+        const float* col = columns[id];
+        for (size_t i = 0; i < n; ++i) out[i] += wk * col[i];
+    }
+}
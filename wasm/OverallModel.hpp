@@ -0,0 +1,51 @@
+#pragma once
+// ============================================================================
+// OverallModel.hpp — Position-aware overall rating formula
+// ============================================================================
+//
+// RAT_OVERALL is stored in the record like any other rating; the game does
+// not derive it. This model derives it as a weighted mean of the component
+// ratings (RatingID 1..42, display units), with one weight row per position
+// (VITAL_POSITION 0..4 = PG, SG, SF, PF, C) and a generic row, the mean of
+// the five, for records with an unknown position byte.
+//
+// Weights are relative: each row is normalized to sum to 1 when used. The
+// defaults favor shooting/handling for guards and inside/rebounding/defense
+// for bigs; callers can override any weight.
+// ============================================================================
+
+#include <cstddef>
+
+class OverallModel {
+public:
+    static constexpr int POSITION_COUNT = 5;         // PG, SG, SF, PF, C
+    static constexpr int GENERIC_ROW    = POSITION_COUNT;
+    static constexpr int ROW_COUNT      = POSITION_COUNT + 1;
+    static constexpr int RATING_COUNT   = 43;        // == RAT_COUNT
+
+    OverallModel();
+
+    void   reset_defaults();
+    void   set_weight(int position, int rating_id, double weight);
+    double get_weight(int position, int rating_id) const;
+
+    // Weight row for a VITAL_POSITION value (unknown → generic row).
+    static int row_for(int position) {
+        return position >= 0 && position < POSITION_COUNT ? position : GENERIC_ROW;
+    }
+
+    // Overall (display units, unrounded) for one player.
+    // `ratings` holds RATING_COUNT display values indexed by RatingID.
+    float evaluate(const float* ratings, int row) const;
+
+    // Column-major batch over `n` players sharing one weight row:
+    // columns[id][i] is rating `id` of player i. Writes out[0..n).
+    void evaluate_batch(const float* const* columns, size_t n, int row, float* out) const;
+
+private:
+    float weights_[ROW_COUNT][RATING_COUNT];      // As set (relative)
+    float normalized_[ROW_COUNT][RATING_COUNT];   // Rows summing to 1
+
+    void normalize(int row);
+    void rebuild_generic();
+};
@@ -0,0 +1,153 @@
+// ============================================================================
+// PlayerGenerator.cpp — Archetype fitting and correlated sampling
+// ============================================================================
+
+#include "PlayerGenerator.hpp"
+#include "RosterStatus.hpp"
+#include <algorithm>
+#include <cmath>
+
+// Off-diagonal covariance kept after shrinking towards the diagonal, and
+// the variance floor that keeps constant dimensions factorizable.
+static constexpr double COVARIANCE_KEEP = 0.95;
+static constexpr double VARIANCE_FLOOR  = 1e-3;
+
+PlayerGenerator::PlayerGenerator()
+    : seed_(1), position_(-1), quality_(0), spread_(1),
+      first_year_(0), last_year_(0), cfid_base_(1)
+{}
+
+// ============================================================================
+// Options
+// ============================================================================
+
+void PlayerGenerator::set_seed(int seed) {
+    seed_ = static_cast<uint32_t>(seed);
+}
+
+void PlayerGenerator::set_position(int position) {
+    if (position < -1 || position >= OverallModel::POSITION_COUNT) {
+        roster_fail(ROSTER_ERR_INVALID_ARGUMENT, "PlayerGenerator::set_position: position must be -1..4");
+        return;
+    }
+    position_ = position;
+}
+
+void PlayerGenerator::set_quality(double offset) {
+    if (!std::isfinite(offset)) {
+        roster_fail(ROSTER_ERR_INVALID_ARGUMENT, "PlayerGenerator::set_quality: offset must be finite");
+        return;
+    }
+    quality_ = offset;
+}
+
+void PlayerGenerator::set_spread(double scale) {
+    if (!(scale >= 0) || !std::isfinite(scale)) {
+        roster_fail(ROSTER_ERR_INVALID_ARGUMENT, "PlayerGenerator::set_spread: scale must be >= 0");
+        return;
+    }
+    spread_ = scale;
+}
+
+void PlayerGenerator::set_birth_years(int first, int last) {
+    bool keep = first == 0 && last == 0;
+    if (!keep && (first < 1 || first > last || last > 0xFFFF)) {
+        roster_fail(ROSTER_ERR_INVALID_ARGUMENT, "PlayerGenerator::set_birth_years: bad year range");
+        return;
+    }
+    first_year_ = first;
+    last_year_  = last;
+}
+
+void PlayerGenerator::set_cfid_base(int cfid) {
+    if (cfid < 1 || cfid >= 0xFFFF) {
+        roster_fail(ROSTER_ERR_INVALID_ARGUMENT, "PlayerGenerator::set_cfid_base: CFID must be 1..65534");
+        return;
+    }
+    cfid_base_ = cfid;
+}
+
+// ============================================================================
+// Archetypes
+// ============================================================================
+// Covariance is accumulated in double over centered columns, one pass per
+// (i, j ≤ i) pair. The Cholesky factor is stored packed by rows, so a draw
+// is one forward pass over DIMS(DIMS+1)/2 floats.
+
+void PlayerGenerator::clear_archetypes() {
+    for (Archetype& a : archetypes_) a = Archetype();
+}
+
+void PlayerGenerator::fit(int row, const float* samples, int n) {
+    Archetype& a = archetypes_[row];
+    a.mean.assign(DIMS, 0.0f);
+    a.lo.assign(DIMS, 0.0f);
+    a.hi.assign(DIMS, 0.0f);
+    a.lower.assign(static_cast<size_t>(DIMS) * (DIMS + 1) / 2, 0.0f);
+    a.ready = true;
+    if (n <= 0) return;
+
+    std::vector<double> centered(static_cast<size_t>(DIMS) * n);
+    for (int d = 0; d < DIMS; ++d) {
+        double sum = 0;
+        float lo = samples[d], hi = samples[d];
+        for (int k = 0; k < n; ++k) {
+            float v = samples[static_cast<size_t>(k) * DIMS + d];
+            sum += v;
+            lo = std::min(lo, v);
+            hi = std::max(hi, v);
+        }
+        double mean = sum / n;
+        a.mean[d] = static_cast<float>(mean);
+        a.lo[d] = lo;
+        a.hi[d] = hi;
+        double* col = centered.data() + static_cast<size_t>(d) * n;
+        for (int k = 0; k < n; ++k) col[k] = samples[static_cast<size_t>(k) * DIMS + d] - mean;
+    }
+
+    const double norm = 1.0 / std::max(n - 1, 1);
+    std::vector<double> cov(static_cast<size_t>(DIMS) * DIMS);
+    for (int i = 0; i < DIMS; ++i) {
+        const double* ci = centered.data() + static_cast<size_t>(i) * n;
+        for (int j = 0; j <= i; ++j) {
+            const double* cj = centered.data() + static_cast<size_t>(j) * n;
+            double s = 0;
+            for (int k = 0; k < n; ++k) s += ci[k] * cj[k];
+            s *= norm;
+            cov[static_cast<size_t>(i) * DIMS + j] = i == j ? s + VARIANCE_FLOOR : s * COVARIANCE_KEEP;
+        }
+    }
+
+    // In-place Cholesky on the lower triangle.
+    for (int i = 0; i < DIMS; ++i) {
+        double* ri = cov.data() + static_cast<size_t>(i) * DIMS;
+        for (int j = 0; j <= i; ++j) {
+            const double* rj = cov.data() + static_cast<size_t>(j) * DIMS;
+            double s = ri[j];
+            for (int k = 0; k < j; ++k) s -= ri[k] * rj[k];
+            if (i == j) ri[i] = std::sqrt(std::max(s, VARIANCE_FLOOR));
+            else        ri[j] = s / rj[j];
+        }
+    }
+    float* packed = a.lower.data();
+    for (int i = 0; i < DIMS; ++i) {
+        for (int j = 0; j <= i; ++j) *packed++ = static_cast<float>(cov[static_cast<size_t>(i) * DIMS + j]);
+    }
+}
+
+void PlayerGenerator::sample(int row, RandomStream& rng, float* out) const {
+    const Archetype& a = archetypes_[row];
+    float z[DIMS];
+    for (int d = 0; d < DIMS; ++d) z[d] = static_cast<float>(rng.normal());
+
+    const float spread = static_cast<float>(spread_);
+    const float* l = a.lower.data();
+    for (int i = 0; i < DIMS; ++i) {
+        float dev = 0.0f;
+        for (int j = 0; j <= i; ++j) dev += l[j] * z[j];
+        l += i + 1;
+        float shift = i < RATING_DIMS ? static_cast<float>(quality_) : 0.0f;
+        float v = a.mean[i] + shift + spread * dev;
+        out[i] = std::min(std::max(v, a.lo[i] + shift), a.hi[i] + shift);
+    }
+}
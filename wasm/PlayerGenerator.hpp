@@ -0,0 +1,89 @@
+#pragma once
+// ============================================================================
+// PlayerGenerator.hpp — Synthetic players from position archetypes
+// ============================================================================
+//
+// Fills free player slots with new, plausible players:
+//
+//     PlayerGenerator g;
+//     g.set_seed(2014);
+//     g.set_position(4);                    // Centers only; -1 = roster mix
+//     g.set_quality(-8);                    // A weaker draft class
+//     g.set_birth_years(1994, 1996);
+//     editor.generate_players(g, 60, out_ptr);
+//
+// An archetype is learned per OverallModel position row from the loaded
+// roster itself: the mean and covariance of the 42 component ratings, the
+// 58 tendencies, height and weight over that row's live players. New players
+// are drawn as mean + L·z (L the Cholesky factor, z standard normal), so the
+// correlations of real players carry over — a generated center with a high
+// block rating also tends to be tall, rebound and post up. The covariance is
+// shrunk slightly towards its diagonal, which keeps the factorization stable
+// for rows with few players.
+//
+// Fields the model does not cover come from donor players of the same
+// position: one donor supplies the base record (appearance, contract, draft
+// details), another the gear set and another the signature skills; each
+// animation and hot zone is drawn from its own donor, and first and last
+// names from two unrelated players. Everything derives from one RandomStream
+// seeded by set_seed(), so a seed and a roster always yield the same players.
+// ============================================================================
+
+#include "RosterEditor.hpp"
+#include "Random.hpp"
+#include <cstdint>
+#include <vector>
+
+class PlayerGenerator {
+public:
+    // Archetype vector layout: component ratings (RatingID 1..42, display
+    // units), tendencies, then the height and weight vitals.
+    static constexpr int RATING_DIMS   = RAT_COUNT - 1;   // RAT_OVERALL is derived
+    static constexpr int TENDENCY_DIMS = TEND_COUNT;
+    static constexpr int HEIGHT_DIM    = RATING_DIMS + TENDENCY_DIMS;
+    static constexpr int WEIGHT_DIM    = HEIGHT_DIM + 1;
+    static constexpr int DIMS          = WEIGHT_DIM + 1;
+
+    PlayerGenerator();
+
+    // -- Options (bad values report ROSTER_ERR_INVALID_ARGUMENT) -------------
+    void set_seed(int seed);
+    void set_position(int position);            // VITAL_POSITION 0..4; -1 (default) = roster mix
+    void set_quality(double offset);            // Added to every rating mean, default 0
+    void set_spread(double scale);              // Scales deviations from the mean, default 1
+    void set_birth_years(int first, int last);  // Default 0, 0 = the donor's year
+    void set_cfid_base(int cfid);               // Lowest CFID handed out, default 1
+
+    // -- Used by RosterEditor::generate_players ------------------------------
+    uint64_t seed() const             { return seed_; }
+    int      position() const         { return position_; }
+    int      first_birth_year() const { return first_year_; }
+    int      last_birth_year() const  { return last_year_; }
+    int      cfid_base() const        { return cfid_base_; }
+
+    // Learn row's archetype from n sample vectors (DIMS floats each,
+    // row-major). Replaces any earlier fit of that row.
+    void fit(int row, const float* samples, int n);
+    bool has_archetype(int row) const { return archetypes_[row].ready; }
+    void clear_archetypes();
+
+    // Draw one vector: quality and spread applied, each dimension clamped to
+    // the range the row's players span (rating bounds shifted by quality).
+    void sample(int row, RandomStream& rng, float* out) const;
+
+private:
+    struct Archetype {
+        bool               ready = false;
+        std::vector<float> mean;    // DIMS
+        std::vector<float> lower;   // Cholesky factor, packed rows: L[i][0..i]
+        std::vector<float> lo, hi;  // Observed range per dimension
+    };
+
+    uint64_t seed_;
+    int      position_;
+    double   quality_;
+    double   spread_;
+    int      first_year_, last_year_;
+    int      cfid_base_;
+    Archetype archetypes_[OverallModel::ROW_COUNT];
+};
@@ -0,0 +1,67 @@
+#pragma once
+// ============================================================================
+// Random.hpp — Small seeded PRNG for the solvers and generators
+// ============================================================================
+//
+// xorshift64*, seeded through the splitmix64 finalizer so nearby seeds
+// diverge at once. Eight bytes of state and a few shifts per draw; the
+// same seed always yields the same stream on every platform, which is what
+// makes balancer plans and generated players reproducible.
+// ============================================================================
+
+#include <cmath>
+#include <cstdint>
+
+class RandomStream {
+public:
+    explicit RandomStream(uint64_t seed) : state_(mix_seed(seed)), spare_(0), has_spare_(false) {}
+
+    static uint64_t mix_seed(uint64_t x) {
+        x += 0x9E3779B97F4A7C15ULL;
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+        x ^= x >> 31;
+        return x ? x : 1;
+    }
+
+    uint64_t next() {
+        state_ ^= state_ >> 12;
+        state_ ^= state_ << 25;
+        state_ ^= state_ >> 27;
+        return state_ * 2685821657736338717ULL;
+    }
+
+    // Uniform in [0, 1).
+    double unit() {
+        return static_cast<double>(next() >> 11) * (1.0 / 9007199254740992.0);
+    }
+
+    // Uniform in [0, n); n > 0. The 64-bit modulo bias is negligible.
+    uint32_t below(uint32_t n) {
+        return static_cast<uint32_t>(next() % n);
+    }
+
+    // Standard normal, Marsaglia's polar method; the second value of each
+    // pair is kept for the next call.
+    double normal() {
+        if (has_spare_) {
+            has_spare_ = false;
+            return spare_;
+        }
+        double u, v, s;
+        do {
+            u = 2.0 * unit() - 1.0;
+            v = 2.0 * unit() - 1.0;
+            s = u * u + v * v;
+        } while (s >= 1.0 || s == 0.0);
+        double f = std::sqrt(-2.0 * std::log(s) / s);
+        spare_ = v * f;
+        has_spare_ = true;
+        return u * f;
+    }
+
+private:
+    uint64_t state_;
+    double   spare_;
+    bool     has_spare_;
+};
@@ -0,0 +1,366 @@
+// ============================================================================
+// RosterBalancer.cpp — Parallel simulated annealing over roster changes
+// ============================================================================
+
+#include "RosterBalancer.hpp"
+#include "OverallModel.hpp"
+#include "RosterStatus.hpp"
+#include "Random.hpp"
+#include "TaskScheduler.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+static constexpr double NO_TARGET = std::numeric_limits<double>::quiet_NaN();
+
+RosterBalancer::RosterBalancer()
+    : kind_(FIELD_RATING), id_(RAT_OVERALL), any_team_(true), target_(NO_TARGET),
+      position_mask_(-1), moves_(BALANCE_ADJUST | BALANCE_TRADE), max_adjust_(3),
+      same_position_(true), cost_point_(0.02), cost_trade_(0.25),
+      iterations_(200000), restarts_(4), seed_(1),
+      planned_(false), cost_before_(0), cost_after_(0)
+{}
+
+// ============================================================================
+// Options
+// ============================================================================
+
+void RosterBalancer::set_field(int kind, int id) {
+    FieldLoc loc;
+    if (!locate_player_field(kind, id, loc)) {
+        roster_fail(ROSTER_ERR_INVALID_ARGUMENT, "RosterBalancer::set_field: unknown field");
+        return;
+    }
+    kind_ = kind;
+    id_   = id;
+}
+
+void RosterBalancer::add_team(int team) {
+    if (team < 0 || team > 0xFFFF) {
+        roster_fail(ROSTER_ERR_OUT_OF_RANGE, "RosterBalancer::add_team: team out of range");
+        return;
+    }
+    if (static_cast<size_t>(team) >= teams_.size()) teams_.resize(static_cast<size_t>(team) + 1, 0);
+    teams_[team] = 1;
+    any_team_ = false;
+}
+
+void RosterBalancer::clear_teams() {
+    teams_.clear();
+    any_team_ = true;
+}
+
+void RosterBalancer::set_target(double value) {
+    target_ = value;
+}
+
+void RosterBalancer::set_team_target(int team, double value) {
+    if (team < 0 || team > 0xFFFF) {
+        roster_fail(ROSTER_ERR_OUT_OF_RANGE, "RosterBalancer::set_team_target: team out of range");
+        return;
+    }
+    if (static_cast<size_t>(team) >= team_targets_.size()) {
+        team_targets_.resize(static_cast<size_t>(team) + 1, NO_TARGET);
+    }
+    team_targets_[team] = value;
+}
+
+void RosterBalancer::clear_targets() {
+    target_ = NO_TARGET;
+    team_targets_.clear();
+}
+
+void RosterBalancer::set_position_mask(int mask) {
+    position_mask_ = mask;
+}
+
+void RosterBalancer::lock_player(int player) {
+    if (player < 0 || player > 0xFFFF) {
+        roster_fail(ROSTER_ERR_OUT_OF_RANGE, "RosterBalancer::lock_player: player out of range");
+        return;
+    }
+    size_t word = static_cast<size_t>(player) >> 6;
+    if (word >= locked_.size()) locked_.resize(word + 1, 0);
+    locked_[word] |= uint64_t(1) << (player & 63);
+}
+
+void RosterBalancer::clear_locks() {
+    locked_.clear();
+}
+
+void RosterBalancer::set_moves(int mask) {
+    if (mask <= 0 || (mask & ~(BALANCE_ADJUST | BALANCE_TRADE))) {
+        roster_fail(ROSTER_ERR_INVALID_ARGUMENT, "RosterBalancer::set_moves: unknown move mask");
+        return;
+    }
+    moves_ = mask;
+}
+
+void RosterBalancer::set_max_adjust(int points) {
+    max_adjust_ = std::max(points, 0);
+}
+
+void RosterBalancer::set_same_position_trades(bool enabled) {
+    same_position_ = enabled;
+}
+
+void RosterBalancer::set_costs(double per_point, double per_trade) {
+    if (!(per_point >= 0) || !(per_trade >= 0)) {
+        roster_fail(ROSTER_ERR_INVALID_ARGUMENT, "RosterBalancer::set_costs: costs must be >= 0");
+        return;
+    }
+    cost_point_ = per_point;
+    cost_trade_ = per_trade;
+}
+
+void RosterBalancer::set_iterations(int n) {
+    iterations_ = std::max(n, 0);
+}
+
+void RosterBalancer::set_restarts(int n) {
+    restarts_ = std::min(std::max(n, 1), 64);
+}
+
+void RosterBalancer::set_seed(int seed) {
+    seed_ = static_cast<uint32_t>(seed);
+}
+
+bool RosterBalancer::wants_team(int team) const {
+    if (any_team_) return true;
+    return team >= 0 && static_cast<size_t>(team) < teams_.size() && teams_[team];
+}
+
+bool RosterBalancer::counts_position(int position) const {
+    if (position_mask_ < 0) return true;
+    return position >= 0 && position < 31 && ((position_mask_ >> position) & 1);
+}
+
+bool RosterBalancer::is_locked(int player) const {
+    size_t word = static_cast<size_t>(player) >> 6;
+    return player >= 0 && word < locked_.size() && ((locked_[word] >> (player & 63)) & 1);
+}
+
+int RosterBalancer::get_changes(size_t out_ptr, int max_changes) const {
+    Change* out = reinterpret_cast<Change*>(out_ptr);
+    if (out) {
+        size_t n = std::min(changes_.size(), static_cast<size_t>(std::max(max_changes, 0)));
+        std::copy(changes_.begin(), changes_.begin() + n, out);
+    }
+    return static_cast<int>(changes_.size());
+}
+
+void RosterBalancer::clear_plan() {
+    planned_ = false;
+    entries_.clear();
+    placements_.clear();
+    changes_.clear();
+    cost_before_ = cost_after_ = 0;
+}
+
+// ============================================================================
+// Annealing
+// ============================================================================
+// Teams are renumbered 0..T-1 in order of first appearance. A chain's state
+// is each entry's current team and field delta; team sums are kept alongside
+// so every move is scored from the two or three terms it touches.
+
+struct BalanceSetup {
+    std::vector<int>    value, home, row;
+    std::vector<int>    movable;                // Entry indices
+    std::vector<std::vector<int>> by_row;       // Movable entries per trade pool
+    std::vector<int>    count;                  // Entries per team
+    std::vector<double> target;
+    int    lo, hi, max_adjust, moves, iterations;
+    double cost_point, cost_trade;
+};
+
+struct BalanceState {
+    std::vector<int> team, delta;
+    double cost;
+};
+
+static inline double team_term(double sum, int count, double target) {
+    if (count == 0) return 0;
+    double d = sum / count - target;
+    return d * d;
+}
+
+static double state_cost(const BalanceSetup& s, const BalanceState& st) {
+    std::vector<double> sum(s.count.size(), 0.0);
+    double cost = 0;
+    for (size_t k = 0; k < st.team.size(); ++k) {
+        sum[st.team[k]] += s.value[k] + st.delta[k];
+        cost += s.cost_point * std::abs(st.delta[k]);
+        if (st.team[k] != s.home[k]) cost += 0.5 * s.cost_trade;
+    }
+    for (size_t t = 0; t < sum.size(); ++t) cost += team_term(sum[t], s.count[t], s.target[t]);
+    return cost;
+}
+
+static void run_chain(const BalanceSetup& s, uint64_t seed, BalanceState& best) {
+    const size_t teams = s.count.size();
+    BalanceState cur;
+    cur.team = s.home;
+    cur.delta.assign(s.home.size(), 0);
+    cur.cost = state_cost(s, cur);
+    best = cur;
+    if (s.movable.empty() || s.iterations == 0) return;
+
+    std::vector<double> sum(teams, 0.0);
+    for (size_t k = 0; k < cur.team.size(); ++k) sum[cur.team[k]] += s.value[k];
+
+    // Geometric cooling from the average team term down by four decades.
+    const double t0 = std::max(cur.cost / static_cast<double>(teams), 1e-3);
+    const double cooling = std::pow(1e-4, 1.0 / s.iterations);
+    double temp = t0;
+
+    RandomStream rng(seed);
+    const size_t m = s.movable.size();
+    const bool both = s.moves == (BALANCE_ADJUST | BALANCE_TRADE);
+
+    for (int it = 0; it < s.iterations; ++it, temp *= cooling) {
+        uint64_t r = rng.next();
+        bool trade = both ? (r >> 63) != 0 : s.moves == BALANCE_TRADE;
+        int k1 = s.movable[(r >> 8) % m];
+        int t1 = cur.team[k1];
+        double delta_cost;
+
+        if (!trade) {
+            int d  = (r & 1) ? 1 : -1;
+            int nd = cur.delta[k1] + d;
+            int v  = s.value[k1] + nd;
+            if (std::abs(nd) > s.max_adjust || v < s.lo || v > s.hi) continue;
+            delta_cost = team_term(sum[t1] + d, s.count[t1], s.target[t1])
+                       - team_term(sum[t1], s.count[t1], s.target[t1])
+                       + s.cost_point * (std::abs(nd) - std::abs(cur.delta[k1]));
+            if (delta_cost > 0 && rng.unit() >= std::exp(-delta_cost / temp)) continue;
+            cur.delta[k1] = nd;
+            sum[t1] += d;
+        } else {
+            const std::vector<int>& pool = s.by_row[s.by_row.size() == 1 ? 0 : s.row[k1]];
+            int k2 = pool[rng.next() % pool.size()];
+            int t2 = cur.team[k2];
+            if (t1 == t2) continue;
+            double v1 = s.value[k1] + cur.delta[k1];
+            double v2 = s.value[k2] + cur.delta[k2];
+            double s1 = sum[t1] - v1 + v2;
+            double s2 = sum[t2] - v2 + v1;
+            int away = (t2 != s.home[k1]) - (t1 != s.home[k1]) + (t1 != s.home[k2]) - (t2 != s.home[k2]);
+            delta_cost = team_term(s1, s.count[t1], s.target[t1]) - team_term(sum[t1], s.count[t1], s.target[t1])
+                       + team_term(s2, s.count[t2], s.target[t2]) - team_term(sum[t2], s.count[t2], s.target[t2])
+                       + 0.5 * s.cost_trade * away;
+            if (delta_cost > 0 && rng.unit() >= std::exp(-delta_cost / temp)) continue;
+            cur.team[k1] = t2;
+            cur.team[k2] = t1;
+            sum[t1] = s1;
+            sum[t2] = s2;
+        }
+
+        cur.cost += delta_cost;
+        if (cur.cost < best.cost - 1e-12) {
+            best.team  = cur.team;
+            best.delta = cur.delta;
+            best.cost  = cur.cost;
+        }
+    }
+    best.cost = state_cost(s, best);   // Drop accumulated rounding
+}
+
+// ============================================================================
+// Solve
+// ============================================================================
+
+int RosterBalancer::solve(std::vector<Entry> entries, int lo, int hi) {
+    clear_plan();
+    entries_ = std::move(entries);
+    const size_t n = entries_.size();
+
+    BalanceSetup s;
+    s.lo = lo;
+    s.hi = hi;
+    s.max_adjust = max_adjust_;
+    s.moves      = moves_;
+    s.iterations = iterations_;
+    s.cost_point = cost_point_;
+    s.cost_trade = cost_trade_;
+
+    std::vector<int> local_of;     // Team index → local team
+    std::vector<int> team_of;      // Local team → team index
+    std::vector<double> base;
+    s.value.resize(n);
+    s.home.resize(n);
+    s.row.resize(n);
+    for (size_t k = 0; k < n; ++k) {
+        const Entry& e = entries_[k];
+        if (static_cast<size_t>(e.team) >= local_of.size()) local_of.resize(static_cast<size_t>(e.team) + 1, -1);
+        if (local_of[e.team] < 0) {
+            local_of[e.team] = static_cast<int>(team_of.size());
+            team_of.push_back(e.team);
+            s.count.push_back(0);
+            base.push_back(0);
+        }
+        int t = local_of[e.team];
+        s.value[k] = e.value;
+        s.home[k]  = t;
+        s.row[k]   = same_position_ ? e.row : 0;
+        ++s.count[t];
+        base[t] += e.value;
+        if (e.movable) s.movable.push_back(static_cast<int>(k));
+    }
+
+    // Targets: per team, else the global one, else the league mean.
+    const size_t teams = team_of.size();
+    double league = 0;
+    for (size_t t = 0; t < teams; ++t) league += base[t] / s.count[t];
+    league = teams ? league / teams : 0;
+    s.target.resize(teams);
+    for (size_t t = 0; t < teams; ++t) {
+        int team = team_of[t];
+        double v = static_cast<size_t>(team) < team_targets_.size() ? team_targets_[team] : NO_TARGET;
+        if (std::isnan(v)) v = std::isnan(target_) ? league : target_;
+        s.target[t] = v;
+    }
+
+    // Trade pools: one per position row, or a single shared pool.
+    s.by_row.resize(same_position_ ? OverallModel::ROW_COUNT : 1);
+    for (int k : s.movable) s.by_row[s.row[k]].push_back(k);
+
+    std::vector<BalanceState> chains(static_cast<size_t>(restarts_));
+    TaskScheduler::shared().parallel_for(chains.size(), 1, [&](size_t begin, size_t end) {
+        for (size_t c = begin; c < end; ++c) run_chain(s, seed_ * 0x100000001ULL + c, chains[c]);
+    });
+    size_t winner = 0;
+    for (size_t c = 1; c < chains.size(); ++c) {
+        if (chains[c].cost < chains[winner].cost) winner = c;
+    }
+    const BalanceState& best = chains[winner];
+
+    BalanceState start;
+    start.team  = s.home;
+    start.delta.assign(n, 0);
+    cost_before_ = state_cost(s, start);
+    cost_after_  = best.cost;
+
+    // Each team gives up as many entries as it receives (trades are swaps):
+    // incoming players take the vacated slots in entry order.
+    std::vector<std::vector<int>> outgoing(teams), incoming(teams);
+    for (size_t k = 0; k < n; ++k) {
+        if (best.team[k] == s.home[k]) continue;
+        outgoing[s.home[k]].push_back(static_cast<int>(k));
+        incoming[best.team[k]].push_back(static_cast<int>(k));
+    }
+    for (size_t t = 0; t < teams; ++t) {
+        for (size_t i = 0; i < incoming[t].size(); ++i) {
+            placements_.push_back({ incoming[t][i], team_of[t], entries_[outgoing[t][i]].slot });
+        }
+    }
+
+    for (size_t k = 0; k < n; ++k) {
+        if (best.team[k] == s.home[k] && best.delta[k] == 0) continue;
+        changes_.push_back({ entries_[k].player, entries_[k].team, team_of[best.team[k]], best.delta[k] });
+    }
+    std::sort(changes_.begin(), changes_.end(),
+              [](const Change& a, const Change& b) { return a.player < b.player; });
+    planned_ = true;
+    return static_cast<int>(changes_.size());
+}
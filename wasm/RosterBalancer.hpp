@@ -0,0 +1,132 @@
+#pragma once
+// ============================================================================
+// RosterBalancer.hpp — Rebalance team averages with minimal player changes
+// ============================================================================
+//
+// Moves each team's average of one field (RAT_OVERALL by default) towards a
+// target — the league average unless set — by adjusting that field on
+// individual players and/or trading players between rosters:
+//
+//     RosterBalancer b;
+//     for (int t = 0; t < 30; ++t) b.add_team(t);
+//     b.set_moves(BALANCE_ADJUST | BALANCE_TRADE);
+//     b.set_max_adjust(3);                 // No player moves more than ±3
+//     editor.plan_balance(b);              // Solve; nothing is written yet
+//     editor.apply_balance(b);             // One batched write of the plan
+//
+// The objective is Σ (team average − target)² plus a cost per adjusted
+// point and per trade (a two-player swap; each player away from their home
+// team carries half of it), so the solver prefers few, small changes.
+// It runs simulated annealing over O(1)-delta moves: ±1 on one player, or a
+// swap of two players between teams (same position row by default, which
+// keeps every team's position depth intact). Independent chains with
+// different seeds run in parallel on the TaskScheduler and the best one
+// wins; chains are seeded from set_seed(), so results do not depend on the
+// worker count. set_position_mask() restricts which players count (e.g.
+// centers only, to balance frontcourt depth).
+// ============================================================================
+
+#include "RosterEditor.hpp"
+#include <cstdint>
+#include <vector>
+
+enum BalanceMove {
+    BALANCE_ADJUST = 1,   // Change the field on individual players
+    BALANCE_TRADE  = 2    // Swap players between the selected teams
+};
+
+class RosterBalancer {
+public:
+    // Packed result record, 16 bytes, one per changed player.
+    struct Change {
+        int32_t player;
+        int32_t from_team;   // Team index before / after; equal unless traded
+        int32_t to_team;
+        int32_t delta;       // Field change in accessor units
+    };
+
+    // One counted roster slot, gathered by RosterEditor::plan_balance.
+    struct Entry {
+        int32_t team;        // Team index
+        int32_t slot;        // Roster slot 0..14
+        int32_t player;
+        int32_t value;       // Field value in accessor units
+        int32_t row;         // OverallModel position row (trade matching)
+        bool    movable;     // Unlocked and listed on one selected team only
+    };
+
+    RosterBalancer();
+
+    // -- Problem (bad values report ROSTER_ERR_INVALID_ARGUMENT) -------------
+    void set_field(int kind, int id);          // Default FIELD_RATING, RAT_OVERALL
+    void add_team(int team);                   // None added = every team
+    void clear_teams();
+    void set_target(double value);             // For every team; default league mean
+    void set_team_target(int team, double value);
+    void clear_targets();
+    void set_position_mask(int mask);          // Bit p = VITAL_POSITION p counts; -1 all
+    void lock_player(int player);              // Never adjusted or traded
+    void clear_locks();
+
+    // -- Search --------------------------------------------------------------
+    void set_moves(int mask);                  // BalanceMove bits, default both
+    void set_max_adjust(int points);           // Per player, default 3
+    void set_same_position_trades(bool enabled);   // Default on
+    void set_costs(double per_point, double per_trade);   // per_trade is per swap; default 0.02, 0.25
+    void set_iterations(int n);                // Per chain, default 200000
+    void set_restarts(int n);                  // Chains, default 4
+    void set_seed(int seed);
+
+    // -- Result of the last plan ---------------------------------------------
+    int    get_change_count() const { return static_cast<int>(changes_.size()); }
+    // Writes up to max_changes Change records to out_ptr; returns the total.
+    int    get_changes(size_t out_ptr, int max_changes) const;
+    double get_cost_before() const { return cost_before_; }
+    double get_cost_after() const  { return cost_after_; }
+
+    // -- Used by RosterEditor ------------------------------------------------
+    int  field_kind() const { return kind_; }
+    int  field_id() const   { return id_; }
+    bool wants_team(int team) const;
+    bool counts_position(int position) const;
+    bool is_locked(int player) const;
+
+    // Solve over the gathered entries (field domain [lo, hi]) and keep the
+    // plan. Returns the number of changed players.
+    int  solve(std::vector<Entry> entries, int lo, int hi);
+    bool has_plan() const { return planned_; }
+
+    // Slot moves of the plan: entry index → destination (team, slot).
+    struct Placement {
+        int32_t entry;
+        int32_t team;
+        int32_t slot;
+    };
+    const std::vector<Entry>&     entries() const    { return entries_; }
+    const std::vector<Placement>& placements() const { return placements_; }
+    const std::vector<Change>&    changes() const    { return changes_; }
+    void clear_plan();
+
+private:
+    // Options
+    int    kind_, id_;
+    std::vector<uint8_t> teams_;         // Selected team indices (bitmap by index)
+    bool   any_team_;
+    double target_;                      // NaN = league mean
+    std::vector<double> team_targets_;   // NaN = target_
+    int    position_mask_;
+    std::vector<uint64_t> locked_;
+    int    moves_;
+    int    max_adjust_;
+    bool   same_position_;
+    double cost_point_, cost_trade_;
+    int    iterations_, restarts_;
+    uint32_t seed_;
+
+    // Plan
+    bool   planned_;
+    std::vector<Entry>     entries_;
+    std::vector<Placement> placements_;
+    std::vector<Change>    changes_;
+    double cost_before_, cost_after_;
+};
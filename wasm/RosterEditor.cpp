@@ -5,13 +5,19 @@
 //   1. Player table discovery via Team Table marker (0x2850EC)
 //   2. Player struct field access (CFID at +28, ratings, names)
 //   3. CRC32 checksum: zlib crc32 over payload, byte-swapped to LE, at [0..3]
+//   4. Name dictionary decode (see NameTable.cpp)
 // ============================================================================
 
 #include "RosterEditor.hpp"
+#include "RosterTransform.hpp"
+#include "FieldSearch.hpp"
+#include "RosterBalancer.hpp"
+#include "PlayerGenerator.hpp"
 #include "BitStream.hpp"
 #include <cstring>
-#include <stdexcept>
+#include <cmath>
 #include <algorithm>
+#include <new>
 
 // zlib for CRC32 — in Emscripten this is available via USE_ZLIB=1 flag
 // For standalone builds, link against zlib
@@ -33,6 +39,25 @@ static constexpr size_t TEAM_TABLE_MARKER = 0x2850EC;
 static constexpr size_t CFID_OFFSET       = 28;   // +28 bytes from player record start
 static constexpr size_t CFID_SIZE         = 2;     // 16-bit integer
 
+// Null slots (CAP templates, empty roster spots) carry CFID 0 or 65535.
+static inline bool record_is_null(const uint8_t* rec) {
+    uint16_t cfid = static_cast<uint16_t>(rec[CFID_OFFSET] | (rec[CFID_OFFSET + 1] << 8));
+    return cfid == 0 || cfid == 0xFFFF;
+}
+
+// Bit sets over player slots / CFIDs.
+static inline bool test_bit(const std::vector<uint64_t>& bits, size_t i) {
+    return (bits[i >> 6] >> (i & 63)) & 1u;
+}
+
+static inline void set_bit(std::vector<uint64_t>& bits, size_t i) {
+    bits[i >> 6] |= uint64_t(1) << (i & 63);
+}
+
+static inline void clear_bit(std::vector<uint64_t>& bits, size_t i) {
+    bits[i >> 6] &= ~(uint64_t(1) << (i & 63));
+}
+
 // ============================================================================
 // Rating byte offsets (relative to player record start)
 // ============================================================================
@@ -54,58 +79,79 @@ static constexpr size_t LAST_NAME_OFFSET  = 56;    // Offset to last name pointe
 // Position info
 static constexpr size_t POSITION_OFFSET   = 60;    // Position byte
 
+// Vitals read directly by bulk passes (see get_vital_by_id for the full set)
+static constexpr size_t VITAL_POSITION_OFFSET = 33;
+static constexpr size_t VITAL_TEAM_ID1_OFFSET = 1;
+static constexpr size_t VITAL_HEIGHT_OFFSET   = 34;
+static constexpr size_t VITAL_WEIGHT_OFFSET   = 35;
+static constexpr size_t VITAL_BIRTH_OFFSET    = 37;    // Day, month, u16 year
+static constexpr size_t VITAL_TEAM_ID2_OFFSET = 267;
+static constexpr size_t VITAL_JERSEY_BIT      = 13 * 8 + 4;   // 8 bits, MSB-first
+static constexpr int    FREE_AGENT_TEAM_ID    = 255;
+
+// Team record layout: 15 uint16 player indices from +108
+static constexpr size_t TEAM_ROSTER_OFFSET = 108;
+
 // Default player record size (for 2K14 roster format)
 // This is the BINARY byte size of one player record in the .ROS file,
 // NOT the number of logical fields. Confirmed exactly 911 via hex analysis.
-static constexpr size_t DEFAULT_RECORD_SIZE = 1023;
+static constexpr size_t DEFAULT_RECORD_SIZE = Player::RECORD_SIZE;
 
 // Maximum expected player count — NBA 2K14 database is exactly 1664 slots
 static constexpr int MAX_PLAYERS = 1664;
+static_assert(MAX_PLAYERS <= 64 * 64, "free-slot summary must fit one word");
+
+// Unit of work for parallel whole-buffer passes (checksum, export copy)
+static constexpr size_t CRC_SLICE = 1 << 20;
 
 // ============================================================================
 // Player Implementation
 // ============================================================================
 
+// Target of default / rejected handles: they read zeros, and every writer
+// below returns early when buffer_ points here, so it is never written.
+alignas(8) static const uint8_t NULL_RECORD[Player::RECORD_SIZE] = {};
+static_assert(Team::RECORD_SIZE <= Player::RECORD_SIZE, "NULL_RECORD must fit a team");
+
 Player::Player()
-    : buffer_(nullptr), buffer_length_(0), record_offset_(0)
+    : buffer_(const_cast<uint8_t*>(NULL_RECORD)), record_offset_(0),
+      editor_(nullptr), index_(-1)
 {}
 
-Player::Player(uint8_t* buffer, size_t buffer_length, size_t record_offset)
-    : buffer_(buffer), buffer_length_(buffer_length), record_offset_(record_offset)
-{}
+Player::Player(uint8_t* buffer, size_t buffer_length, size_t record_offset,
+               RosterEditor* editor, int index)
+    : buffer_(buffer), record_offset_(record_offset),
+      editor_(editor), index_(index)
+{
+    if (!buffer || record_offset > buffer_length || buffer_length - record_offset < RECORD_SIZE) {
+        roster_fail(ROSTER_ERR_OUT_OF_RANGE, "Player: record extends beyond buffer");
+        *this = Player();
+    }
+}
 
 // -- Low-level accessors ------------------------------------------------------
+// No bounds checks: every field offset used below lies inside RECORD_SIZE.
 
 uint8_t Player::read_byte_at(size_t offset) const {
-    size_t abs_offset = record_offset_ + offset;
-    if (abs_offset >= buffer_length_) {
-        throw std::out_of_range("Player::read_byte_at: offset beyond buffer");
-    }
-    return buffer_[abs_offset];
+    return buffer_[record_offset_ + offset];
 }
 
 void Player::write_byte_at(size_t offset, uint8_t value) {
+    if (buffer_ == NULL_RECORD) return;
     size_t abs_offset = record_offset_ + offset;
-    if (abs_offset >= buffer_length_) {
-        throw std::out_of_range("Player::write_byte_at: offset beyond buffer");
-    }
+    if (editor_) editor_->note_write(abs_offset, 1);
     buffer_[abs_offset] = value;
 }
 
 uint16_t Player::read_u16_le(size_t offset) const {
-    size_t abs_offset = record_offset_ + offset;
-    if (abs_offset + 1 >= buffer_length_) {
-        throw std::out_of_range("Player::read_u16_le: offset beyond buffer");
-    }
-    return static_cast<uint16_t>(buffer_[abs_offset])
-         | (static_cast<uint16_t>(buffer_[abs_offset + 1]) << 8);
+    const uint8_t* p = buffer_ + record_offset_ + offset;
+    return static_cast<uint16_t>(p[0] | (p[1] << 8));
 }
 
 void Player::write_u16_le(size_t offset, uint16_t value) {
+    if (buffer_ == NULL_RECORD) return;
     size_t abs_offset = record_offset_ + offset;
-    if (abs_offset + 1 >= buffer_length_) {
-        throw std::out_of_range("Player::write_u16_le: offset beyond buffer");
-    }
+    if (editor_) editor_->note_write(abs_offset, 2);
     buffer_[abs_offset]     = static_cast<uint8_t>(value & 0xFF);
     buffer_[abs_offset + 1] = static_cast<uint8_t>((value >> 8) & 0xFF);
 }
@@ -131,9 +177,11 @@ int Player::get_cfid() const {
 
 void Player::set_cfid(int new_cfid) {
     if (new_cfid < 0 || new_cfid > 65535) {
-        throw std::out_of_range("CFID must be 0–65535");
+        roster_fail(ROSTER_ERR_OUT_OF_RANGE, "CFID must be 0–65535");
+        return;
     }
     write_u16_le(CFID_OFFSET, static_cast<uint16_t>(new_cfid));
+    if (editor_) editor_->on_cfid_changed(index_);
 }
 
 // -- Data-driven ratings ------------------------------------------------------
@@ -146,6 +194,7 @@ int Player::get_rating_by_id(int id) const {
 void Player::set_rating_by_id(int id, int display_value) {
     if (id < 0 || id >= RAT_COUNT) return;
     write_byte_at(RATING_OFFSETS[id], display_to_raw(display_value));
+    if (editor_ && id != RAT_OVERALL) editor_->on_rating_changed(index_);
 }
 
 // -- Legacy named rating accessors (delegate to data-driven) ------------------
@@ -163,21 +212,58 @@ void Player::set_overall_rating(int r)       { set_rating_by_id(RAT_OVERALL, r);
 
 // -- Name reading -------------------------------------------------------------
 
+// ARCHITECTURAL NOTE: Text names are NOT stored in the 1023-byte player record.
+// The offsets hold 16-bit Name IDs into the global name table, which the
+// editor decodes once at init. Detached players (or rosters without a
+// recognizable table) fall back to the numeric ID.
+
+int Player::get_first_name_id() const {
+    return static_cast<int>(read_u16_le(FIRST_NAME_OFFSET));
+}
+
+int Player::get_last_name_id() const {
+    return static_cast<int>(read_u16_le(LAST_NAME_OFFSET));
+}
+
 std::string Player::get_first_name() const {
-    // ARCHITECTURAL NOTE: Text names are NOT stored in the 1023-byte player record.
-    // The offsets hold 16-bit Name IDs, not ASCII. Attempting to read_string_at()
-    // on these integers produces garbage. Until we map the global NameData.txt
-    // dictionary, return the CFID as a clean identifier.
-    uint16_t id = read_u16_le(FIRST_NAME_OFFSET);
+    int id = get_first_name_id();
+    if (editor_ && id < editor_->get_name_table().size()) {
+        return std::string(editor_->get_name_table().get(id));
+    }
     return std::to_string(id);
 }
 
 std::string Player::get_last_name() const {
-    // Name IDs, not ASCII — return empty until Name Dictionary is mapped
-    uint16_t id = read_u16_le(LAST_NAME_OFFSET);
+    int id = get_last_name_id();
+    if (editor_ && id < editor_->get_name_table().size()) {
+        return std::string(editor_->get_name_table().get(id));
+    }
     return std::to_string(id);
 }
 
+void Player::set_first_name(const std::string& name) { set_name_at(FIRST_NAME_OFFSET, name); }
+void Player::set_last_name(const std::string& name)  { set_name_at(LAST_NAME_OFFSET, name); }
+
+void Player::set_name_at(size_t offset, const std::string& name) {
+    if (!editor_ || !editor_->get_name_table().is_loaded()) {
+        roster_fail(ROSTER_ERR_NAME_TABLE, "Player::set_name: name table not loaded");
+        return;
+    }
+    NameTable& names = editor_->get_name_table();
+    int current = static_cast<int>(read_u16_le(offset));
+    int id = names.assign(current, name);
+    if (id < 0) {
+        roster_fail(ROSTER_ERR_NAME_TABLE, "Player::set_name: name table is full");
+        return;
+    }
+    if (id != current) {
+        names.release(current);
+        names.add_ref(id);
+        write_u16_le(offset, static_cast<uint16_t>(id));
+    }
+    editor_->reindex_player(index_);
+}
+
 // -- Position -----------------------------------------------------------------
 
 int Player::get_position() const {
@@ -301,29 +387,28 @@ void Player::set_vital_by_id(int id, int value) {
         case VITAL_FINANCIAL_SECURITY: write_byte_at(59, value & 0xFF); break;
         case VITAL_PLAY_FOR_WINNER: write_byte_at(57, value & 0xFF); break;
     }
+    if (editor_ && id == VITAL_POSITION) editor_->on_rating_changed(index_);
 }
 
 // -- Bit-packed helpers -------------------------------------------------------
-// These create a temporary BitStream over the entire buffer, jump to the
-// player's record_offset_ + the specified (byte, bit) delta, then read/write
-// the requested number of bits. This mirrors the C# pattern:
+// Fields are addressed as record_offset_ + (byte, bit) delta, mirroring the
+// C# pattern:
 //   brOpen.MoveStreamToPortraitID(i);      // → record_offset_
-//   brOpen.MoveStreamPosition(byte, bit);  // → jump_to + delta
-//   brOpen.ReadNBAByte(N);                 // → read_bits(N)
+//   brOpen.MoveStreamPosition(byte, bit);  // → (byte_off, bit_off)
+//   brOpen.ReadNBAByte(N);                 // → peek_bits(N)
+// The record span was validated at construction, so no cursor is needed.
 
 uint32_t Player::read_bits_at(size_t byte_off, int bit_off, int count) const {
-    // const_cast is safe: BitStream won't write in read_bits()
-    BitStream bs(const_cast<uint8_t*>(buffer_), buffer_length_);
-    bs.jump_to(record_offset_);
-    bs.move(static_cast<int>(byte_off), bit_off);
-    return bs.read_bits(count);
+    return BitStream::peek_bits(buffer_ + record_offset_, byte_off * 8 + static_cast<size_t>(bit_off), count);
 }
 
 void Player::write_bits_at(size_t byte_off, int bit_off, int count, uint32_t value) {
-    BitStream bs(buffer_, buffer_length_);
-    bs.jump_to(record_offset_);
-    bs.move(static_cast<int>(byte_off), bit_off);
-    bs.write_bits(value, count);
+    if (buffer_ == NULL_RECORD) return;
+    size_t first_bit = byte_off * 8 + static_cast<size_t>(bit_off);
+    if (editor_) {
+        editor_->note_write(record_offset_ + first_bit / 8, (first_bit % 8 + count + 7) / 8);
+    }
+    BitStream::poke_bits(buffer_ + record_offset_, first_bit, count, value);
 }
 
 // ============================================================================
@@ -331,52 +416,65 @@ void Player::write_bits_at(size_t byte_off, int bit_off, int count, uint32_t val
 // ============================================================================
 
 Team::Team()
-    : buffer_(nullptr), buffer_length_(0), record_offset_(0)
+    : buffer_(const_cast<uint8_t*>(NULL_RECORD)), record_offset_(0),
+      editor_(nullptr), index_(-1)
 {}
 
-Team::Team(uint8_t* buffer, size_t buffer_length, size_t record_offset)
-    : buffer_(buffer), buffer_length_(buffer_length), record_offset_(record_offset)
-{}
+Team::Team(uint8_t* buffer, size_t buffer_length, size_t record_offset,
+           RosterEditor* editor, int index)
+    : buffer_(buffer), record_offset_(record_offset),
+      editor_(editor), index_(index)
+{
+    if (!buffer || record_offset > buffer_length || buffer_length - record_offset < RECORD_SIZE) {
+        roster_fail(ROSTER_ERR_OUT_OF_RANGE, "Team: record extends beyond buffer");
+        *this = Team();
+    }
+}
 
 // -- Low-level accessors ------------------------------------------------------
+// Unchecked, as for Player: all offsets below are inside RECORD_SIZE.
 
 uint8_t Team::read_byte_at(size_t offset) const {
-    size_t abs_offset = record_offset_ + offset;
-    if (abs_offset >= buffer_length_) throw std::out_of_range("Team::read_byte_at");
-    return buffer_[abs_offset];
+    return buffer_[record_offset_ + offset];
 }
 
 void Team::write_byte_at(size_t offset, uint8_t value) {
+    if (buffer_ == NULL_RECORD) return;
     size_t abs_offset = record_offset_ + offset;
-    if (abs_offset >= buffer_length_) throw std::out_of_range("Team::write_byte_at");
+    if (editor_) editor_->note_write(abs_offset, 1);
     buffer_[abs_offset] = value;
 }
 
+void Team::read_chars_at(size_t offset, size_t count, char* out) const {
+    std::memcpy(out, buffer_ + record_offset_ + offset, count);
+    out[count] = '\0';
+}
+
 uint16_t Team::read_u16_le(size_t offset) const {
-    size_t abs_offset = record_offset_ + offset;
-    if (abs_offset + 1 >= buffer_length_) throw std::out_of_range("Team::read_u16_le");
-    return static_cast<uint16_t>(buffer_[abs_offset]) | (static_cast<uint16_t>(buffer_[abs_offset + 1]) << 8);
+    const uint8_t* p = buffer_ + record_offset_ + offset;
+    return static_cast<uint16_t>(p[0] | (p[1] << 8));
 }
 
 void Team::write_u16_le(size_t offset, uint16_t value) {
+    if (buffer_ == NULL_RECORD) return;
     size_t abs_offset = record_offset_ + offset;
-    if (abs_offset + 1 >= buffer_length_) throw std::out_of_range("Team::write_u16_le");
+    if (editor_) editor_->note_write(abs_offset, 2);
     buffer_[abs_offset] = value & 0xFF;
     buffer_[abs_offset + 1] = (value >> 8) & 0xFF;
 }
 
 uint32_t Team::read_u32_le(size_t offset) const {
-    size_t abs_offset = record_offset_ + offset;
-    if (abs_offset + 3 >= buffer_length_) throw std::out_of_range("Team::read_u32_le");
-    return static_cast<uint32_t>(buffer_[abs_offset])
-         | (static_cast<uint32_t>(buffer_[abs_offset + 1]) << 8)
-         | (static_cast<uint32_t>(buffer_[abs_offset + 2]) << 16)
-         | (static_cast<uint32_t>(buffer_[abs_offset + 3]) << 24);
+    const uint8_t* p = buffer_ + record_offset_ + offset;
+    return static_cast<uint32_t>(p[0])
+         | (static_cast<uint32_t>(p[1]) << 8)
+         | (static_cast<uint32_t>(p[2]) << 16)
+         | (static_cast<uint32_t>(p[3]) << 24);
 }
 
 void Team::write_u32_le(size_t offset, uint32_t value) {
+    if (buffer_ == NULL_RECORD) return;
     size_t abs_offset = record_offset_ + offset;
-    if (abs_offset + 3 >= buffer_length_) throw std::out_of_range("Team::write_u32_le");
+    if (editor_) editor_->note_write(abs_offset, 4);
     buffer_[abs_offset] = value & 0xFF;
     buffer_[abs_offset + 1] = (value >> 8) & 0xFF;
     buffer_[abs_offset + 2] = (value >> 16) & 0xFF;
@@ -389,42 +487,48 @@ int Team::get_id() const {
     return static_cast<int>(read_byte_at(0)); // Usually ID is first byte or so, need to verify
 }
 
+// City, name and abbreviation are fixed-width, NUL-padded ASCII fields.
+static constexpr size_t TEAM_CITY_OFFSET = 1;
+static constexpr size_t TEAM_NAME_OFFSET = 33;
+static constexpr size_t TEAM_ABBR_OFFSET = 65;
+static constexpr size_t TEAM_STRING_LEN  = 32;
+static constexpr size_t TEAM_ABBR_LEN    = 4;
+
 std::string Team::get_name() const {
-    char b[33];
-    for(int i=0; i<32; i++) b[i] = static_cast<char>(read_byte_at(33 + i));
-    b[32] = '\0';
+    char b[TEAM_STRING_LEN + 1];
+    read_chars_at(TEAM_NAME_OFFSET, TEAM_STRING_LEN, b);
     return std::string(b);
 }
 
 std::string Team::get_city() const {
-    char b[33];
-    for(int i=0; i<32; i++) b[i] = static_cast<char>(read_byte_at(1 + i));
-    b[32] = '\0';
+    char b[TEAM_STRING_LEN + 1];
+    read_chars_at(TEAM_CITY_OFFSET, TEAM_STRING_LEN, b);
     return std::string(b);
 }
 
 std::string Team::get_abbr() const {
-    char b[5];
-    for(int i=0; i<4; i++) b[i] = static_cast<char>(read_byte_at(65 + i));
-    b[4] = '\0';
+    char b[TEAM_ABBR_LEN + 1];
+    read_chars_at(TEAM_ABBR_OFFSET, TEAM_ABBR_LEN, b);
     return std::string(b);
 }
 
 void Team::set_name(const std::string& name) {
-    for(int i=0; i<32; i++) {
-        write_byte_at(33 + i, i < static_cast<int>(name.length()) ? static_cast<uint8_t>(name[i]) : 0);
+    for(size_t i=0; i<TEAM_STRING_LEN; i++) {
+        write_byte_at(TEAM_NAME_OFFSET + i, i < name.length() ? static_cast<uint8_t>(name[i]) : 0);
     }
+    if (editor_) editor_->reindex_team(index_);
 }
 
 void Team::set_city(const std::string& city) {
-    for(int i=0; i<32; i++) {
-        write_byte_at(1 + i, i < static_cast<int>(city.length()) ? static_cast<uint8_t>(city[i]) : 0);
+    for(size_t i=0; i<TEAM_STRING_LEN; i++) {
+        write_byte_at(TEAM_CITY_OFFSET + i, i < city.length() ? static_cast<uint8_t>(city[i]) : 0);
     }
+    if (editor_) editor_->reindex_team(index_);
 }
 
 void Team::set_abbr(const std::string& abbr) {
-    for(int i=0; i<4; i++) {
-        write_byte_at(65 + i, i < static_cast<int>(abbr.length()) ? static_cast<uint8_t>(abbr[i]) : 0);
+    for(size_t i=0; i<TEAM_ABBR_LEN; i++) {
+        write_byte_at(TEAM_ABBR_OFFSET + i, i < abbr.length() ? static_cast<uint8_t>(abbr[i]) : 0);
     }
 }
 
@@ -451,13 +555,32 @@ void Team::set_color2(uint32_t argb) {
 // Each slot is a 16-bit player index
 
 int Team::get_roster_player_id(int index) const {
-    if (index < 0 || index >= 15) return -1;
-    return static_cast<int>(read_u16_le(108 + index * 2));
+    if (index < 0 || index >= ROSTER_SLOTS) return -1;
+    return static_cast<int>(read_u16_le(TEAM_ROSTER_OFFSET + index * 2));
 }
 
 void Team::set_roster_player_id(int index, int player_id) {
-    if (index < 0 || index >= 15) return;
-    write_u16_le(108 + index * 2, static_cast<uint16_t>(player_id));
+    if (index < 0 || index >= ROSTER_SLOTS) return;
+    int previous = read_u16_le(TEAM_ROSTER_OFFSET + index * 2);
+    write_u16_le(TEAM_ROSTER_OFFSET + index * 2, static_cast<uint16_t>(player_id));
+    if (editor_) editor_->on_roster_slot_changed(previous, read_u16_le(TEAM_ROSTER_OFFSET + index * 2));
+}
+
+void Team::decode(TeamInfo& out) const {
+    out.color1 = get_color1();
+    out.color2 = get_color2();
+    out.index  = static_cast<uint16_t>(index_);
+    out.id     = static_cast<uint16_t>(get_id());
+    out.roster_count = 0;
+    for (int i = 0; i < ROSTER_SLOTS; ++i) {
+        uint16_t p = read_u16_le(TEAM_ROSTER_OFFSET + i * 2);
+        out.roster[i] = p;
+        if (p != ROSTER_EMPTY && p != 0) ++out.roster_count;
+    }
+    read_chars_at(TEAM_CITY_OFFSET, TEAM_STRING_LEN, out.city);
+    read_chars_at(TEAM_NAME_OFFSET, TEAM_STRING_LEN, out.name);
+    read_chars_at(TEAM_ABBR_OFFSET, TEAM_ABBR_LEN, out.abbr);
+    out.reserved = 0;
 }
 
 // ============================================================================
@@ -582,6 +705,90 @@ void Player::set_sig_skill(int slot, int val) {
     write_bits_at(bo, bi, 6, static_cast<uint32_t>(val & 0x3F));
 }
 
+// ============================================================================
+// Block access — tendencies, hot zones, sig skills
+// ============================================================================
+// The 58 tendencies are one 464-bit run (byte 144, bit 3), immediately
+// followed by the 28 hot zone bits; the 5 sig skills are a 30-bit run at
+// byte 14, bit 3. Tendencies move through BitStream::peek_block/poke_block;
+// the two short runs fit one peek_bits/poke_bits window each.
+
+static constexpr size_t TENDENCY_BLOCK_BIT = TENDENCY_BASE_BYTE * 8 + TENDENCY_BASE_BIT;
+static constexpr size_t SIG_SKILL_BLOCK_BIT = SIG_SKILL_BASE_BYTE * 8 + SIG_SKILL_BASE_BIT;
+
+void Player::get_tendencies(uint8_t* out) const {
+    BitStream::peek_block(buffer_ + record_offset_, TENDENCY_BLOCK_BIT, out, TEND_COUNT);
+    for (int i = 0; i < TEND_COUNT; ++i) out[i] &= 0x7F;
+}
+
+void Player::set_tendencies(const uint8_t* in) {
+    if (buffer_ == NULL_RECORD) return;
+    uint8_t block[TEND_COUNT];
+    BitStream::peek_block(buffer_ + record_offset_, TENDENCY_BLOCK_BIT, block, TEND_COUNT);
+    for (int i = 0; i < TEND_COUNT; ++i) {
+        block[i] = static_cast<uint8_t>((block[i] & 0x80) | (in[i] & 0x7F));
+    }
+    // The run spans TEND_COUNT + 1 bytes (it starts mid-byte).
+    if (editor_) editor_->note_write(record_offset_ + TENDENCY_BASE_BYTE, TEND_COUNT + 1);
+    BitStream::poke_block(buffer_ + record_offset_, TENDENCY_BLOCK_BIT, block, TEND_COUNT);
+}
+
+void Player::get_hot_zones(uint8_t* out) const {
+    const int n = get_hot_zone_count();
+    uint32_t run = BitStream::peek_bits(buffer_ + record_offset_, HOT_ZONE_BASE_BITS, n * 2);
+    for (int z = 0; z < n; ++z) out[z] = static_cast<uint8_t>((run >> (2 * (n - 1 - z))) & 0x3);
+}
+
+void Player::set_hot_zones(const uint8_t* in) {
+    const int n = get_hot_zone_count();
+    uint32_t run = 0;
+    for (int z = 0; z < n; ++z) run = (run << 2) | (in[z] & 0x3u);
+    write_bits_at(HOT_ZONE_BASE_BITS / 8, HOT_ZONE_BASE_BITS % 8, n * 2, run);
+}
+
+void Player::get_sig_skills(uint8_t* out) const {
+    const int n = get_sig_skill_count();
+    uint32_t run = BitStream::peek_bits(buffer_ + record_offset_, SIG_SKILL_BLOCK_BIT, n * 6);
+    for (int s = 0; s < n; ++s) out[s] = static_cast<uint8_t>((run >> (6 * (n - 1 - s))) & 0x3F);
+}
+
+void Player::set_sig_skills(const uint8_t* in) {
+    const int n = get_sig_skill_count();
+    uint32_t run = 0;
+    for (int s = 0; s < n; ++s) run = (run << 6) | (in[s] & 0x3Fu);
+    write_bits_at(SIG_SKILL_BASE_BYTE, SIG_SKILL_BASE_BIT, n * 6, run);
+}
+
+int Player::read_tendency_block(size_t out_ptr) const {
+    get_tendencies(reinterpret_cast<uint8_t*>(out_ptr));
+    return TEND_COUNT;
+}
+
+int Player::write_tendency_block(size_t in_ptr) {
+    set_tendencies(reinterpret_cast<const uint8_t*>(in_ptr));
+    return TEND_COUNT;
+}
+
+int Player::read_hot_zone_block(size_t out_ptr) const {
+    get_hot_zones(reinterpret_cast<uint8_t*>(out_ptr));
+    return get_hot_zone_count();
+}
+
+int Player::write_hot_zone_block(size_t in_ptr) {
+    set_hot_zones(reinterpret_cast<const uint8_t*>(in_ptr));
+    return get_hot_zone_count();
+}
+
+int Player::read_sig_skill_block(size_t out_ptr) const {
+    get_sig_skills(reinterpret_cast<uint8_t*>(out_ptr));
+    return get_sig_skill_count();
+}
+
+int Player::write_sig_skill_block(size_t in_ptr) {
+    set_sig_skills(reinterpret_cast<const uint8_t*>(in_ptr));
+    return get_sig_skill_count();
+}
+
 // ============================================================================
 // Gear — 48 mixed bit-width fields starting at Byte 129, Bit 7
 // ============================================================================
@@ -620,6 +827,108 @@ void Player::set_gear_by_id(int id, uint32_t value) {
     write_bits_at(bo, bi, GEAR_DEFS[id].bit_width, value & mask);
 }
 
+// -- Gear codec -----------------------------------------------------------------
+// All 48 fields share one 230-bit run. The codec copies that run once into
+// four big-endian 64-bit words (GEAR_WINDOW_BYTES, gear bit 0 = MSB of
+// word 0) and extracts or inserts each field through a plan of (word, shift,
+// width) entries precomputed from GEAR_DEFS.
+
+static constexpr size_t GEAR_BLOCK_BIT    = GEAR_BASE_BYTE * 8 + GEAR_BASE_BIT;
+static constexpr int    GEAR_BITS         = GEAR_DEFS[GEAR_COUNT - 1].bit_offset + GEAR_DEFS[GEAR_COUNT - 1].bit_width;
+static constexpr size_t GEAR_WINDOW_BYTES = (GEAR_BITS + 7) / 8;
+static constexpr int    GEAR_WORDS        = 4;
+static_assert(GEAR_WINDOW_BYTES <= GEAR_WORDS * 8, "gear run must fit the codec window");
+
+struct GearSlot {
+    int word;    // Word holding the field's first bit
+    int shift;   // Bits before the field in that word
+    int width;
+};
+
+struct GearPlan {
+    GearSlot slots[GEAR_COUNT];
+};
+
+static constexpr GearPlan make_gear_plan() {
+    GearPlan plan{};
+    for (int i = 0; i < GEAR_COUNT; ++i) {
+        plan.slots[i] = { GEAR_DEFS[i].bit_offset / 64, GEAR_DEFS[i].bit_offset % 64, GEAR_DEFS[i].bit_width };
+    }
+    return plan;
+}
+
+static constexpr GearPlan GEAR_PLAN = make_gear_plan();
+
+static void load_gear_window(const uint8_t* record, uint64_t (&words)[GEAR_WORDS]) {
+    uint8_t bytes[GEAR_WORDS * 8] = {};
+    BitStream::peek_block(record, GEAR_BLOCK_BIT, bytes, GEAR_WINDOW_BYTES);
+    for (int w = 0; w < GEAR_WORDS; ++w) {
+        uint64_t v = 0;
+        for (int b = 0; b < 8; ++b) v = (v << 8) | bytes[w * 8 + b];
+        words[w] = v;
+    }
+}
+
+static void store_gear_window(uint8_t* record, const uint64_t (&words)[GEAR_WORDS]) {
+    uint8_t bytes[GEAR_WORDS * 8];
+    for (int w = 0; w < GEAR_WORDS; ++w) {
+        uint64_t v = words[w];
+        for (int b = 7; b >= 0; --b) {
+            bytes[w * 8 + b] = static_cast<uint8_t>(v);
+            v >>= 8;
+        }
+    }
+    BitStream::poke_block(record, GEAR_BLOCK_BIT, bytes, GEAR_WINDOW_BYTES);
+}
+
+void Player::get_gear(uint32_t* out) const {
+    uint64_t words[GEAR_WORDS];
+    load_gear_window(buffer_ + record_offset_, words);
+    for (int i = 0; i < GEAR_COUNT; ++i) {
+        const GearSlot& f = GEAR_PLAN.slots[i];
+        uint64_t v = words[f.word] << f.shift;
+        if (f.shift + f.width > 64) v |= words[f.word + 1] >> (64 - f.shift);
+        out[i] = static_cast<uint32_t>(v >> (64 - f.width));
+    }
+}
+
+void Player::set_gear(const uint32_t* in) {
+    if (buffer_ == NULL_RECORD) return;
+    uint64_t words[GEAR_WORDS];
+    load_gear_window(buffer_ + record_offset_, words);
+    for (int i = 0; i < GEAR_COUNT; ++i) {
+        const GearSlot& f = GEAR_PLAN.slots[i];
+        uint64_t v = in[i] & ((uint64_t(1) << f.width) - 1);
+        int head = std::min(f.width, 64 - f.shift);    // Bits in the first word
+        int tail = f.width - head;
+        uint64_t head_mask = ((uint64_t(1) << head) - 1) << (64 - f.shift - head);
+        words[f.word] = (words[f.word] & ~head_mask) | ((v >> tail) << (64 - f.shift - head));
+        if (tail > 0) {
+            uint64_t tail_mask = ~(~uint64_t(0) >> tail);
+            words[f.word + 1] = (words[f.word + 1] & ~tail_mask) | (v << (64 - tail));
+        }
+    }
+    // The run starts at bit 7 of byte 129, so it spans one extra byte.
+    if (editor_) editor_->note_write(record_offset_ + GEAR_BASE_BYTE, GEAR_WINDOW_BYTES + 1);
+    store_gear_window(buffer_ + record_offset_, words);
+}
+
+void Player::copy_gear_from(const Player& other) {
+    uint32_t gear[GEAR_COUNT];
+    other.get_gear(gear);
+    set_gear(gear);
+}
+
+int Player::read_gear_block(size_t out_ptr) const {
+    get_gear(reinterpret_cast<uint32_t*>(out_ptr));
+    return GEAR_COUNT;
+}
+
+int Player::write_gear_block(size_t in_ptr) {
+    set_gear(reinterpret_cast<const uint32_t*>(in_ptr));
+    return GEAR_COUNT;
+}
+
 // ============================================================================
 // Data-driven Animations (40 items)
 // ============================================================================
@@ -641,6 +950,62 @@ void Player::set_animation_by_id(int id, int val) {
     write_byte_at(ANIM_BASE_OFFSET + id, static_cast<uint8_t>(val & 0xFF));
 }
 
+// ============================================================================
+// Generic field addressing (FieldKind)
+// ============================================================================
+// Mirrors the per-family accessors above as (bit position, width) pairs so
+// bulk code can use BitStream::peek_bits / poke_bits directly. A tendency's
+// value is the low 7 bits of its block: skip the leading category flag.
+
+bool locate_player_field(int kind, int id, FieldLoc& out) {
+    if (id < 0 || id >= player_field_count(kind)) return false;
+    switch (kind) {
+        case FIELD_RATING:
+            out = { static_cast<uint32_t>(RATING_OFFSETS[id] * 8), 8 };
+            return true;
+        case FIELD_TENDENCY:
+            out = { static_cast<uint32_t>(TENDENCY_BASE_BYTE * 8 + TENDENCY_BASE_BIT + id * 8 + 1), 7 };
+            return true;
+        case FIELD_ANIMATION:
+            out = { static_cast<uint32_t>((ANIM_BASE_OFFSET + id) * 8), 8 };
+            return true;
+        case FIELD_HOT_ZONE:
+            out = { static_cast<uint32_t>(HOT_ZONE_BASE_BITS + id * 2), 2 };
+            return true;
+        case FIELD_SIG_SKILL:
+            out = { static_cast<uint32_t>(SIG_SKILL_BASE_BYTE * 8 + SIG_SKILL_BASE_BIT + id * 6), 6 };
+            return true;
+        case FIELD_GEAR:
+            out = { static_cast<uint32_t>(GEAR_BASE_BYTE * 8 + GEAR_BASE_BIT + GEAR_DEFS[id].bit_offset),
+                    GEAR_DEFS[id].bit_width };
+            return true;
+        default:
+            return false;
+    }
+}
+
+int player_field_count(int kind) {
+    switch (kind) {
+        case FIELD_RATING:    return RAT_COUNT;
+        case FIELD_TENDENCY:  return TEND_COUNT;
+        case FIELD_ANIMATION: return ANIM_COUNT;
+        case FIELD_HOT_ZONE:  return Player::get_hot_zone_count();
+        case FIELD_SIG_SKILL: return Player::get_sig_skill_count();
+        case FIELD_GEAR:      return GEAR_COUNT;
+        default:              return 0;
+    }
+}
+
+void player_field_domain(int kind, int id, int& lo, int& hi) {
+    FieldLoc loc;
+    lo = 0;
+    hi = locate_player_field(kind, id, loc) && loc.width < 31 ? (1 << loc.width) - 1 : 0x7FFFFFFF;
+    if (kind == FIELD_RATING) {
+        lo = Player::raw_to_display(0);
+        hi = Player::raw_to_display(255);
+    }
+}
+
 // ============================================================================
 // RosterEditor Implementation
 // ============================================================================
@@ -648,23 +1013,160 @@ void Player::set_animation_by_id(int id, int val) {
 RosterEditor::RosterEditor()
     : buffer_(nullptr), buffer_length_(0),
       player_table_offset_(0), player_count_(0),
-      player_record_size_(DEFAULT_RECORD_SIZE)
+      player_record_size_(DEFAULT_RECORD_SIZE),
+      team_table_offset_(0), team_count_(0), team_record_size_(0),
+      derived_ready_(false), auto_overall_(true), roster_refs_ready_(false),
+      free_words_(0),
+      export_chunk_size_(0), export_pos_(0), export_len_(0), export_crc_(0),
+      load_capacity_(0), load_length_(0)
 {}
 
 RosterEditor::~RosterEditor() {
-    // We do NOT free the buffer — JS owns it via Module._malloc/_free
+    // A buffer passed to init() is NOT freed — JS owns it via Module._malloc/
+    // _free. The prepare_load() buffer is released with load_buffer_, and a
+    // mapped file (native builds) is unmapped by MappedFile's destructor.
 }
 
 void RosterEditor::init(size_t buffer_ptr, int buffer_length) {
-    buffer_        = reinterpret_cast<uint8_t*>(buffer_ptr);
-    buffer_length_ = static_cast<size_t>(buffer_length);
+    uint8_t* buffer = reinterpret_cast<uint8_t*>(buffer_ptr);
+    if (!buffer || buffer_length < 16) {
+        roster_fail(ROSTER_ERR_INVALID_ARGUMENT, "RosterEditor::init: invalid buffer");
+        return;
+    }
+#if ROSTER_HAS_MMAP
+    file_.close();
+#endif
+    attach(buffer, static_cast<size_t>(buffer_length));
+    refresh_derived_state();
+}
+
+// -- Owned load buffer --------------------------------------------------------
+// Capacity grows in LOAD_GRANULE steps so rosters that differ by a few
+// records reuse one allocation. The old block is freed before the new one
+// is taken; keeping both would double the peak heap for no benefit, since
+// the caller is about to overwrite the contents anyway.
+
+static constexpr size_t LOAD_GRANULE = 64 * 1024;
+
+size_t RosterEditor::prepare_load(int length) {
+    if (length < 16) {
+        roster_fail(ROSTER_ERR_INVALID_ARGUMENT, "RosterEditor::prepare_load: invalid length");
+        return 0;
+    }
+    if (load_buffer_ && buffer_ == load_buffer_.get()) detach();
+    load_length_ = 0;
+
+    size_t needed = static_cast<size_t>(length);
+    if (needed > load_capacity_) {
+        load_buffer_.reset();
+        load_capacity_ = 0;
+        size_t capacity = (needed + LOAD_GRANULE - 1) / LOAD_GRANULE * LOAD_GRANULE;
+        load_buffer_.reset(new (std::nothrow) uint8_t[capacity]);
+        if (!load_buffer_) {
+            roster_fail(ROSTER_ERR_OUT_OF_RANGE, "RosterEditor::prepare_load: out of memory");
+            return 0;
+        }
+        load_capacity_ = capacity;
+    }
+    load_length_ = needed;
+    return reinterpret_cast<size_t>(load_buffer_.get());
+}
 
-    if (!buffer_ || buffer_length_ < 16) {
-        throw std::runtime_error("RosterEditor::init: invalid buffer");
+void RosterEditor::load_prepared() {
+    if (load_length_ == 0) {
+        roster_fail(ROSTER_ERR_NO_BUFFER, "RosterEditor::load_prepared: call prepare_load first");
+        return;
     }
+    init(reinterpret_cast<size_t>(load_buffer_.get()), static_cast<int>(load_length_));
+}
+
+void RosterEditor::attach(uint8_t* buffer, size_t length) {
+    buffer_        = buffer;
+    buffer_length_ = length;
+    derived_ready_ = false;
+    reserved_slots_.clear();
+
+    snapshots_.reset(buffer_, buffer_length_);
+    stats_.clear();
+    roster_refs_ready_ = false;
+    export_chunk_size_ = export_pos_ = export_len_ = 0;
+    names_.clear();
+    names_.set_write_hook([this](size_t offset, size_t len) { note_write(offset, len); });
 
     discover_player_table();
     discover_team_table();
+    rebuild_free_slots();
+    vectors_.reset(player_count_);
+    changes_.reset(player_count_, team_count_);
+}
+
+RosterEditor::TableLayout RosterEditor::get_layout() const {
+    return { player_table_offset_, player_record_size_, player_count_,
+             team_table_offset_, team_record_size_, team_count_ };
+}
+
+RosterEditor::TableLayout RosterEditor::discover_layout(uint8_t* buffer, size_t length) {
+    RosterEditor probe;
+    probe.attach(buffer, length);
+    return probe.get_layout();
+}
+
+void RosterEditor::refresh_derived_state() {
+    derived_ready_ = true;
+    load_name_table();
+    build_search_index();
+}
+
+#if ROSTER_HAS_MMAP
+// -- Native file mode ---------------------------------------------------------
+
+void RosterEditor::open_file(const std::string& path, FileMode mode) {
+    // MappedFile::open unmaps the previous file before it can fail, and a
+    // failure may throw — drop every pointer into the old mapping first.
+    detach();
+    if (!file_.open(path, mode)) return;
+    // Discovery walks forward through the file — let the kernel read ahead,
+    // then switch back to random access for edits.
+    file_.advise_sequential(true);
+    attach(file_.data(), file_.length());
+    file_.advise_sequential(false);
+}
+
+void RosterEditor::save_file() {
+    if (!file_.is_open()) {
+        roster_fail(ROSTER_ERR_NO_BUFFER, "RosterEditor::save_file: no file open");
+        return;
+    }
+    if (file_.mode() != FILE_READ_WRITE) {
+        roster_fail(ROSTER_ERR_IO, "RosterEditor::save_file: file opened read-only");
+        return;
+    }
+    write_checksum(file_.payload_crc());
+    if (!file_.sync()) return;
+}
+
+void RosterEditor::close_file() {
+    file_.close();
+    detach();
+}
+#endif
+
+void RosterEditor::detach() {
+    buffer_ = nullptr;
+    buffer_length_ = 0;
+    player_count_ = 0;
+    reserved_slots_.clear();
+    team_count_ = 0;
+    derived_ready_ = false;
+    names_.clear();
+    search_.reset(0);
+    snapshots_.reset(nullptr, 0);
+    stats_.clear();
+    roster_refs_ready_ = false;
+    export_chunk_size_ = export_pos_ = export_len_ = 0;
+    rebuild_free_slots();
+    vectors_.reset(0);
+    changes_.reset(0, 0);
 }
 
 // -- Player Table Discovery ---------------------------------------------------
@@ -750,7 +1252,7 @@ void RosterEditor::discover_player_table() {
 void RosterEditor::discover_team_table() {
     team_table_offset_ = 0;
     team_count_ = 0;
-    team_record_size_ = 716; // Typically 716 bytes in 2K14
+    team_record_size_ = Team::RECORD_SIZE; // 716 bytes in 2K14
 
     // To find the Team Table accurately without static offsets, we look for the unique 
     // sequence of player IDs that make up a known team's roster.
@@ -780,7 +1282,9 @@ void RosterEditor::discover_team_table() {
     if (found_bucks && bucks_array_offset >= (108 + team_record_size_)) {
         size_t team1_start = bucks_array_offset - 108;
         team_table_offset_ = team1_start - team_record_size_;
-        team_count_ = 100; // Expected number of teams in 2K14
+        // 100 teams expected in 2K14; never claim records past the buffer end.
+        size_t fit = (buffer_length_ - team_table_offset_) / team_record_size_;
+        team_count_ = static_cast<int>(std::min<size_t>(100, fit));
     }
 }
 
@@ -788,24 +1292,1508 @@ int RosterEditor::get_player_count() const {
     return player_count_;
 }
 
-Player RosterEditor::get_player(int index) const {
+// The only bounds checks on the player/team path: resolve the index here,
+// and let the handle constructor validate the record span.
+
+Player RosterEditor::get_player(int index) {
     if (index < 0 || index >= player_count_) {
-        throw std::out_of_range("RosterEditor::get_player: index out of range");
+        roster_fail(ROSTER_ERR_OUT_OF_RANGE, "RosterEditor::get_player: index out of range");
+        return Player();
     }
     size_t offset = player_table_offset_ + static_cast<size_t>(index) * player_record_size_;
-    return Player(buffer_, buffer_length_, offset);
+    return Player(buffer_, buffer_length_, offset, this, index);
+}
+
+void RosterEditor::copy_gear(int from, int to) {
+    if (from < 0 || from >= player_count_ || to < 0 || to >= player_count_) {
+        roster_fail(ROSTER_ERR_OUT_OF_RANGE, "RosterEditor::copy_gear: index out of range");
+        return;
+    }
+    get_player(to).copy_gear_from(get_player(from));
+}
+
+// -- Record operations --------------------------------------------------------
+
+bool RosterEditor::check_record_pair(const char* what, int a, int b) const {
+    if (a < 0 || a >= player_count_ || b < 0 || b >= player_count_) {
+        roster_fail(ROSTER_ERR_OUT_OF_RANGE, std::string("RosterEditor::") + what + ": index out of range");
+        return false;
+    }
+    if (a == b) {
+        roster_fail(ROSTER_ERR_INVALID_ARGUMENT, std::string("RosterEditor::") + what + ": indices must differ");
+        return false;
+    }
+    return true;
+}
+
+void RosterEditor::ensure_roster_index() {
+    if (roster_refs_ready_) return;
+    roster_refs_.assign(static_cast<size_t>(player_count_), {});
+    for (int t = 0; t < team_count_; ++t) {
+        const uint8_t* team = buffer_ + team_table_offset_ + static_cast<size_t>(t) * team_record_size_;
+        for (int s = 0; s < Team::ROSTER_SLOTS; ++s) {
+            int p = team[TEAM_ROSTER_OFFSET + s * 2] | (team[TEAM_ROSTER_OFFSET + s * 2 + 1] << 8);
+            if (p == 0 || p >= player_count_) continue;   // Empty (0 / ROSTER_EMPTY) or dangling
+            roster_refs_[p].push_back(static_cast<uint16_t>((t << 4) | s));
+        }
+    }
+    roster_refs_ready_ = true;
+}
+
+void RosterEditor::point_roster_refs(int player, int value) {
+    for (uint16_t ref : roster_refs_[player]) {
+        get_team(ref >> 4).set_roster_player_id(ref & 0xF, value);
+    }
+}
+
+// Keep NameTable reference counts exact across raw record copies.
+void RosterEditor::change_name_refs(int index, bool add) {
+    if (!derived_ready_ || !names_.is_loaded()) return;
+    const uint8_t* rec = buffer_ + player_table_offset_ + static_cast<size_t>(index) * player_record_size_;
+    int ids[2] = { rec[FIRST_NAME_OFFSET] | (rec[FIRST_NAME_OFFSET + 1] << 8),
+                   rec[LAST_NAME_OFFSET]  | (rec[LAST_NAME_OFFSET + 1]  << 8) };
+    for (int id : ids) {
+        if (add) names_.add_ref(id);
+        else     names_.release(id);
+    }
+}
+
+bool RosterEditor::clone_player(int src, int dst) {
+    if (!check_record_pair("clone_player", src, dst)) return false;
+    std::vector<uint16_t> cfid;
+    if (!unused_cfids(1, 1, cfid)) {
+        roster_fail(ROSTER_ERR_OUT_OF_RANGE, "RosterEditor::clone_player: no unused CFID");
+        return false;
+    }
+    ensure_roster_index();
+
+    point_roster_refs(dst, Team::ROSTER_EMPTY);
+    roster_refs_[dst].clear();
+
+    change_name_refs(dst, false);
+    uint8_t* to = buffer_ + player_table_offset_ + static_cast<size_t>(dst) * player_record_size_;
+    note_write(static_cast<size_t>(to - buffer_), player_record_size_);
+    std::memcpy(to, buffer_ + player_table_offset_ + static_cast<size_t>(src) * player_record_size_,
+                player_record_size_);
+    to[CFID_OFFSET]     = static_cast<uint8_t>(cfid[0] & 0xFF);   // Never a duplicate of src
+    to[CFID_OFFSET + 1] = static_cast<uint8_t>(cfid[0] >> 8);
+    change_name_refs(dst, true);
+    refresh_slot(dst);
+
+    Player clone = get_player(dst);
+    clone.set_vital_by_id(VITAL_TEAM_ID1, FREE_AGENT_TEAM_ID);
+    clone.set_vital_by_id(VITAL_TEAM_ID2, FREE_AGENT_TEAM_ID);
+    reindex_player(dst);
+    roster_refs_ready_ = true;   // The slot writes above kept the index current
+    return true;
+}
+
+bool RosterEditor::swap_players(int a, int b) {
+    if (!check_record_pair("swap_players", a, b)) return false;
+    ensure_roster_index();
+
+    uint8_t* ra = buffer_ + player_table_offset_ + static_cast<size_t>(a) * player_record_size_;
+    uint8_t* rb = buffer_ + player_table_offset_ + static_cast<size_t>(b) * player_record_size_;
+    note_write(static_cast<size_t>(ra - buffer_), player_record_size_);
+    note_write(static_cast<size_t>(rb - buffer_), player_record_size_);
+    std::swap_ranges(ra, ra + player_record_size_, rb);
+
+    // Slots that named a now name b (where a's record went), and vice versa.
+    std::swap(roster_refs_[a], roster_refs_[b]);
+    point_roster_refs(a, a);
+    point_roster_refs(b, b);
+    refresh_slot(a);
+    refresh_slot(b);
+    reindex_player(a);
+    reindex_player(b);
+    roster_refs_ready_ = true;
+    return true;
+}
+
+bool RosterEditor::move_player(int src, int dst) {
+    if (!check_record_pair("move_player", src, dst)) return false;
+    ensure_roster_index();
+
+    point_roster_refs(dst, Team::ROSTER_EMPTY);
+    roster_refs_[dst] = std::move(roster_refs_[src]);
+    roster_refs_[src].clear();
+    point_roster_refs(dst, dst);
+
+    uint8_t* from = buffer_ + player_table_offset_ + static_cast<size_t>(src) * player_record_size_;
+    uint8_t* to   = buffer_ + player_table_offset_ + static_cast<size_t>(dst) * player_record_size_;
+    change_name_refs(dst, false);
+    note_write(static_cast<size_t>(to - buffer_), player_record_size_);
+    std::memcpy(to, from, player_record_size_);
+    change_name_refs(dst, true);
+    refresh_slot(dst);
+    reindex_player(dst);
+
+    vacate_record(src);
+    roster_refs_ready_ = true;
+    return true;
+}
+
+void RosterEditor::vacate_record(int index) {
+    uint8_t* rec = buffer_ + player_table_offset_ + static_cast<size_t>(index) * player_record_size_;
+    change_name_refs(index, false);
+    note_write(static_cast<size_t>(rec - buffer_), player_record_size_);
+    std::memset(rec, 0, player_record_size_);
+    change_name_refs(index, true);   // The zeroed record names entry 0, like any other
+    refresh_slot(index);
+    reindex_player(index);
+}
+
+// -- Slot allocation ----------------------------------------------------------
+
+void RosterEditor::set_slot_free(int index, bool free) {
+    uint64_t& word = free_slots_[index >> 6];
+    uint64_t bit = uint64_t(1) << (index & 63);
+    word = free ? (word | bit) : (word & ~bit);
+    uint64_t summary = uint64_t(1) << (index >> 6);
+    free_words_ = word ? (free_words_ | summary) : (free_words_ & ~summary);
+}
+
+// A reservation from allocate_player_slot lasts until the record gets a
+// real CFID or the slot is released, whatever else refreshes it meanwhile.
+void RosterEditor::refresh_slot(int index) {
+    if (index <= 0 || index >= player_count_) return;   // Slot 0 is the dummy player
+    const uint8_t* rec = buffer_ + player_table_offset_ + static_cast<size_t>(index) * player_record_size_;
+    bool null = record_is_null(rec);
+    if (!null) clear_bit(reserved_slots_, static_cast<size_t>(index));
+    set_slot_free(index, null && roster_uses_[index] == 0 && !test_bit(reserved_slots_, static_cast<size_t>(index)));
+}
+
+void RosterEditor::rebuild_free_slots() {
+    const size_t words = static_cast<size_t>(player_count_ + 63) / 64;
+    free_slots_.assign(words, 0);
+    free_words_ = 0;
+    reserved_slots_.resize(words, 0);   // Kept: a snapshot restore does not cancel them
+    roster_uses_.assign(static_cast<size_t>(player_count_), 0);
+    for (int t = 0; t < team_count_; ++t) {
+        const uint8_t* team = buffer_ + team_table_offset_ + static_cast<size_t>(t) * team_record_size_;
+        for (int s = 0; s < Team::ROSTER_SLOTS; ++s) {
+            int p = team[TEAM_ROSTER_OFFSET + s * 2] | (team[TEAM_ROSTER_OFFSET + s * 2 + 1] << 8);
+            if (p > 0 && p < player_count_) ++roster_uses_[p];
+        }
+    }
+    for (int i = 1; i < player_count_; ++i) refresh_slot(i);
+}
+
+int RosterEditor::allocate_player_slot() {
+    if (!free_words_) {
+        roster_fail(ROSTER_ERR_OUT_OF_RANGE, "RosterEditor::allocate_player_slot: no free player slot");
+        return -1;
+    }
+    int word = __builtin_ctzll(free_words_);
+    int index = word * 64 + __builtin_ctzll(free_slots_[word]);
+    set_bit(reserved_slots_, static_cast<size_t>(index));
+    set_slot_free(index, false);
+    return index;
+}
+
+bool RosterEditor::release_player_slot(int index) {
+    if (index <= 0 || index >= player_count_) {
+        roster_fail(ROSTER_ERR_OUT_OF_RANGE, "RosterEditor::release_player_slot: index out of range");
+        return false;
+    }
+    ensure_roster_index();
+    point_roster_refs(index, Team::ROSTER_EMPTY);
+    roster_refs_[index].clear();
+    clear_bit(reserved_slots_, static_cast<size_t>(index));
+    vacate_record(index);
+    roster_refs_ready_ = true;
+    return true;
+}
+
+// CFIDs are handed out lowest-first from one 64K-bit set of those in use;
+// the null values 0 and 0xFFFF are never handed out.
+bool RosterEditor::unused_cfids(int first, int count, std::vector<uint16_t>& out) const {
+    std::vector<uint64_t> used(65536 / 64, 0);
+    set_bit(used, 0);
+    set_bit(used, 0xFFFF);
+    for (int i = 0; i < player_count_; ++i) {
+        const uint8_t* rec = buffer_ + player_table_offset_ + static_cast<size_t>(i) * player_record_size_;
+        set_bit(used, static_cast<uint16_t>(rec[CFID_OFFSET] | (rec[CFID_OFFSET + 1] << 8)));
+    }
+    out.clear();
+    out.reserve(static_cast<size_t>(std::max(count, 0)));
+    for (int c = std::max(first, 1); c < 0xFFFF && static_cast<int>(out.size()) < count; ++c) {
+        if (!test_bit(used, static_cast<size_t>(c))) out.push_back(static_cast<uint16_t>(c));
+    }
+    return static_cast<int>(out.size()) == count;
+}
+
+int RosterEditor::get_free_slot_count() const {
+    int n = 0;
+    for (uint64_t word : free_slots_) n += __builtin_popcountll(word);
+    return n;
+}
+
+void RosterEditor::on_cfid_changed(int index) {
+    refresh_slot(index);
+}
+
+void RosterEditor::on_roster_slot_changed(int old_player, int new_player) {
+    if (old_player == new_player) return;
+    if (old_player > 0 && old_player < player_count_ && roster_uses_[old_player] > 0) {
+        --roster_uses_[old_player];
+        refresh_slot(old_player);
+    }
+    if (new_player > 0 && new_player < player_count_) {
+        ++roster_uses_[new_player];
+        refresh_slot(new_player);
+    }
 }
 
 int RosterEditor::get_team_count() const {
     return team_count_;
 }
 
-Team RosterEditor::get_team(int index) const {
+int RosterEditor::decode_teams(size_t out_ptr) {
+    TeamInfo* out = reinterpret_cast<TeamInfo*>(out_ptr);
+    if (!out) {
+        roster_fail(ROSTER_ERR_INVALID_ARGUMENT, "RosterEditor::decode_teams: null output buffer");
+        return 0;
+    }
+    for (int i = 0; i < team_count_; ++i) {
+        size_t offset = team_table_offset_ + static_cast<size_t>(i) * team_record_size_;
+        Team(buffer_, buffer_length_, offset, this, i).decode(out[i]);
+    }
+    return team_count_;
+}
+
+Team RosterEditor::get_team(int index) {
     if (index < 0 || index >= team_count_) {
-        throw std::out_of_range("RosterEditor::get_team: index out of range");
+        roster_fail(ROSTER_ERR_OUT_OF_RANGE, "RosterEditor::get_team: index out of range");
+        return Team();
     }
     size_t offset = team_table_offset_ + static_cast<size_t>(index) * team_record_size_;
-    return Team(buffer_, buffer_length_, offset);
+    return Team(buffer_, buffer_length_, offset, this, index);
+}
+
+// -- Name Dictionary ----------------------------------------------------------
+// Decode the table once, then count how many players reference each entry so
+// renames know when an entry can be rewritten in place.
+
+void RosterEditor::load_name_table() {
+    if (!names_.load(buffer_, buffer_length_)) return;
+    count_name_refs();
+}
+
+void RosterEditor::count_name_refs() {
+    names_.reset_refs();
+    for (int i = 0; i < player_count_; ++i) {
+        const uint8_t* rec = buffer_ + player_table_offset_ + static_cast<size_t>(i) * player_record_size_;
+        names_.add_ref(rec[FIRST_NAME_OFFSET] | (rec[FIRST_NAME_OFFSET + 1] << 8));
+        names_.add_ref(rec[LAST_NAME_OFFSET]  | (rec[LAST_NAME_OFFSET + 1]  << 8));
+    }
+}
+
+int RosterEditor::get_name_count() {
+    return get_name_table().size();
+}
+
+std::string RosterEditor::get_name(int id) {
+    return std::string(get_name_table().get(id));
+}
+
+bool RosterEditor::rename_name(int id, const std::string& name) {
+    if (!get_name_table().rename(id, name)) return false;
+    reindex_players_named(id);
+    return true;
+}
+
+size_t RosterEditor::get_name_pool_ptr() {
+    return get_name_table().get_pool_ptr();
+}
+
+int RosterEditor::get_name_pool_length() {
+    return static_cast<int>(get_name_table().get_pool_length());
+}
+
+size_t RosterEditor::get_name_offsets_ptr() {
+    return get_name_table().get_offsets_ptr();
+}
+
+int RosterEditor::export_player_name_ids(size_t out_ptr) const {
+    uint16_t* out = reinterpret_cast<uint16_t*>(out_ptr);
+    if (!out) return 0;
+    for (int i = 0; i < player_count_; ++i) {
+        const uint8_t* rec = buffer_ + player_table_offset_ + static_cast<size_t>(i) * player_record_size_;
+        out[i * 2]     = static_cast<uint16_t>(rec[FIRST_NAME_OFFSET] | (rec[FIRST_NAME_OFFSET + 1] << 8));
+        out[i * 2 + 1] = static_cast<uint16_t>(rec[LAST_NAME_OFFSET]  | (rec[LAST_NAME_OFFSET + 1]  << 8));
+    }
+    return player_count_;
+}
+
+// -- Fuzzy Search --------------------------------------------------------------
+// Document slots: players occupy [0, player_count_), teams follow.
+
+void RosterEditor::build_search_index() {
+    search_.reset(player_count_ + team_count_);
+    for (int i = 0; i < player_count_; ++i) reindex_player(i);
+    for (int t = 0; t < team_count_; ++t)   reindex_team(t);
+}
+
+void RosterEditor::reindex_player(int index) {
+    // Not built yet: the lazy build will pick the change up.
+    if (!derived_ready_ || index < 0 || index >= player_count_ || !names_.is_loaded()) return;
+    const uint8_t* rec = buffer_ + player_table_offset_ + static_cast<size_t>(index) * player_record_size_;
+    int first = rec[FIRST_NAME_OFFSET] | (rec[FIRST_NAME_OFFSET + 1] << 8);
+    int last  = rec[LAST_NAME_OFFSET]  | (rec[LAST_NAME_OFFSET + 1]  << 8);
+
+    std::string text(names_.get(first));
+    text.push_back(' ');
+    text.append(names_.get(last));
+    search_.set_document(index, text);
+}
+
+void RosterEditor::reindex_players_named(int name_id) {
+    for (int i = 0; i < player_count_; ++i) {
+        const uint8_t* rec = buffer_ + player_table_offset_ + static_cast<size_t>(i) * player_record_size_;
+        int first = rec[FIRST_NAME_OFFSET] | (rec[FIRST_NAME_OFFSET + 1] << 8);
+        int last  = rec[LAST_NAME_OFFSET]  | (rec[LAST_NAME_OFFSET + 1]  << 8);
+        if (first != name_id && last != name_id) continue;
+        reindex_player(i);
+        changes_.mark(CHANGE_TABLE_PLAYER, i, CHANGE_IDENTITY);   // Displayed name changed
+    }
+}
+
+void RosterEditor::reindex_team(int index) {
+    if (!derived_ready_ || index < 0 || index >= team_count_) return;
+    Team t = get_team(index);
+    search_.set_document(player_count_ + index, t.get_city() + " " + t.get_name());
+}
+
+int RosterEditor::search(const std::string& query, size_t out_ptr, int max_results) {
+    ensure_derived_state();
+    uint32_t* out = reinterpret_cast<uint32_t*>(out_ptr);
+    int n = search_.query(query, out, max_results);
+    for (int i = 0; i < n; ++i) {
+        if (out[i] >= static_cast<uint32_t>(player_count_)) {
+            out[i] = (out[i] - static_cast<uint32_t>(player_count_)) | SEARCH_TEAM_FLAG;
+        }
+    }
+    return n;
+}
+
+// -- Change feed --------------------------------------------------------------
+
+// ChangeGroup of every player record byte, derived from the field locators.
+// Vitals have no locator (their offsets live in the accessor switch), so
+// their bytes are found by setting every vital to all ones on a detached
+// scratch record. Bytes nothing claims count as vitals too.
+static const uint8_t* player_byte_groups() {
+    static const std::vector<uint8_t> map = [] {
+        std::vector<uint8_t> m(Player::RECORD_SIZE, 0);
+        std::vector<uint8_t> scratch(Player::RECORD_SIZE, 0);
+        Player probe(scratch.data(), scratch.size(), 0, nullptr, -1);
+        for (int id = 0; id < VITAL_COUNT; ++id) probe.set_vital_by_id(id, -1);
+        for (size_t b = 0; b < m.size(); ++b) if (scratch[b]) m[b] = CHANGE_VITALS;
+
+        auto cover = [&m](uint32_t bit_pos, int width, uint8_t group) {
+            size_t last = std::min<size_t>((bit_pos + width - 1) / 8, m.size() - 1);
+            for (size_t b = bit_pos / 8; b <= last; ++b) m[b] |= group;
+        };
+        static const uint8_t KIND_GROUP[FIELD_KIND_COUNT] = {
+            CHANGE_RATINGS, CHANGE_TENDENCIES, CHANGE_ANIMATIONS,
+            CHANGE_TENDENCIES, CHANGE_TENDENCIES, CHANGE_GEAR
+        };
+        for (int kind = 0; kind < FIELD_KIND_COUNT; ++kind) {
+            FieldLoc loc;
+            for (int id = 0; locate_player_field(kind, id, loc); ++id) cover(loc.bit_pos, loc.width, KIND_GROUP[kind]);
+        }
+        cover(CFID_OFFSET * 8, 16, CHANGE_IDENTITY);
+        cover(FIRST_NAME_OFFSET * 8, 16, CHANGE_IDENTITY);
+        cover(LAST_NAME_OFFSET * 8, 16, CHANGE_IDENTITY);
+        for (uint8_t& g : m) if (!g) g = CHANGE_VITALS;
+        return m;
+    }();
+    return map.data();
+}
+
+static uint8_t team_byte_groups(size_t lo, size_t hi) {
+    const size_t roster_end = TEAM_ROSTER_OFFSET + Team::ROSTER_SLOTS * 2;
+    uint8_t groups = 0;
+    if (lo < roster_end && hi > TEAM_ROSTER_OFFSET) groups |= CHANGE_ROSTER;
+    if (lo < TEAM_ROSTER_OFFSET || hi > roster_end) groups |= CHANGE_IDENTITY;
+    return groups;
+}
+
+int RosterEditor::drain_changes(size_t out_ptr, int max_changes) {
+    return changes_.drain(reinterpret_cast<RecordChange*>(out_ptr), max_changes);
+}
+
+// -- Snapshots -----------------------------------------------------------------
+
+// Call fn(i) for every record i of a table whose bytes intersect [lo, hi).
+template <typename Fn>
+static void for_each_record_in(size_t lo, size_t hi, size_t table_offset,
+                               size_t record_size, int count, Fn fn) {
+    if (count <= 0 || hi <= table_offset) return;
+    size_t table_end = table_offset + static_cast<size_t>(count) * record_size;
+    if (lo >= table_end) return;
+    size_t first = lo > table_offset ? (lo - table_offset) / record_size : 0;
+    size_t last  = (std::min(hi, table_end) - 1 - table_offset) / record_size;
+    for (size_t i = first; i <= last; ++i) fn(static_cast<int>(i));
+}
+
+void RosterEditor::note_write(size_t abs_offset, size_t length) {
+    snapshots_.before_write(abs_offset, length);
+    const size_t end = abs_offset + length;
+    for_each_record_in(abs_offset, end, player_table_offset_, player_record_size_, player_count_,
+        [&](int i) {
+            size_t base = player_table_offset_ + static_cast<size_t>(i) * player_record_size_;
+            size_t lo = std::max(abs_offset, base) - base;
+            size_t hi = std::min(end, base + player_record_size_) - base;
+            const uint8_t* map = player_byte_groups();
+            uint8_t groups = 0;
+            for (size_t b = lo; b < hi; ++b) groups |= map[b];
+            changes_.mark(CHANGE_TABLE_PLAYER, i, groups);
+            stats_.mark_player(i);
+            vectors_.mark_dirty(i);
+        });
+    for_each_record_in(abs_offset, end, team_table_offset_, team_record_size_, team_count_,
+        [&](int i) {
+            size_t base = team_table_offset_ + static_cast<size_t>(i) * team_record_size_;
+            changes_.mark(CHANGE_TABLE_TEAM, i,
+                          team_byte_groups(std::max(abs_offset, base) - base,
+                                           std::min(end, base + team_record_size_) - base));
+        });
+    if (roster_refs_ready_ && abs_offset + length > team_table_offset_ &&
+        abs_offset < team_table_offset_ + static_cast<size_t>(team_count_) * team_record_size_) {
+        roster_refs_ready_ = false;
+    }
+#if ROSTER_HAS_MMAP
+    if (file_.is_open()) file_.mark_dirty(abs_offset, length);
+#endif
+}
+
+void RosterEditor::create_snapshot(const std::string& name) {
+    snapshots_.create(name);
+}
+
+bool RosterEditor::restore_snapshot(const std::string& name) {
+#if ROSTER_HAS_MMAP
+    // Same file barrier as note_write, run before the pages are rewritten so
+    // the checksum update sees their old content.
+    if (file_.is_open()) {
+        std::vector<uint32_t> pages;
+        snapshots_.pages_to_restore(name, pages);
+        for (uint32_t page : pages) {
+            file_.mark_dirty(static_cast<size_t>(page) * SnapshotStore::PAGE_SIZE, SnapshotStore::PAGE_SIZE);
+        }
+    }
+#endif
+    std::vector<uint32_t> changed;
+    if (!snapshots_.restore(name, &changed)) return false;
+    if (!changed.empty()) {
+        roster_refs_ready_ = false;
+        rebuild_free_slots();
+    }
+    for (uint32_t page : changed) {
+        size_t lo = static_cast<size_t>(page) * SnapshotStore::PAGE_SIZE;
+        for_each_record_in(lo, lo + SnapshotStore::PAGE_SIZE, player_table_offset_, player_record_size_,
+                           player_count_, [this](int i) {
+                               stats_.mark_player(i);
+                               vectors_.mark_dirty(i);
+                               changes_.mark(CHANGE_TABLE_PLAYER, i, CHANGE_ALL);
+                           });
+        for_each_record_in(lo, lo + SnapshotStore::PAGE_SIZE, team_table_offset_, team_record_size_,
+                           team_count_, [this](int i) { changes_.mark(CHANGE_TABLE_TEAM, i, CHANGE_ALL); });
+    }
+    if (changed.empty() || !derived_ready_) return true;
+
+    // The table location is known, so only re-decode it if its pages moved.
+    bool names_changed = false;
+    for (uint32_t page : changed) {
+        if (names_.overlaps(static_cast<size_t>(page) * SnapshotStore::PAGE_SIZE, SnapshotStore::PAGE_SIZE)) {
+            names_changed = true;
+            break;
+        }
+    }
+    if (names_changed) {
+        names_.reload();
+        if (names_.is_loaded()) count_name_refs();
+        build_search_index();
+        return true;
+    }
+
+    // Otherwise only records living on the rewritten pages need attention.
+    if (names_.is_loaded()) count_name_refs();
+    for (uint32_t page : changed) {
+        size_t lo = static_cast<size_t>(page) * SnapshotStore::PAGE_SIZE;
+        size_t hi = lo + SnapshotStore::PAGE_SIZE;
+        for_each_record_in(lo, hi, player_table_offset_, player_record_size_, player_count_,
+                           [this](int i) { reindex_player(i); });
+        for_each_record_in(lo, hi, team_table_offset_, team_record_size_, team_count_,
+                           [this](int i) { reindex_team(i); });
+    }
+    return true;
+}
+
+bool RosterEditor::delete_snapshot(const std::string& name) {
+    return snapshots_.remove(name);
+}
+
+bool RosterEditor::has_snapshot(const std::string& name) const {
+    return snapshots_.has(name);
+}
+
+int RosterEditor::get_snapshot_count() const {
+    return snapshots_.count();
+}
+
+int RosterEditor::get_snapshot_memory() const {
+    return static_cast<int>(snapshots_.memory_bytes());
+}
+
+// -- Bulk transforms ----------------------------------------------------------
+// Three phases over one column (std::vector<float>) per referenced field:
+//   1. one pass over the player table: filter, and gather matching rows;
+//   2. each step is a branch-free loop over its column (auto-vectorized);
+//   3. scatter: round, clamp to the field domain, write only changed values.
+// Ratings are handled in display units, so untouched ratings are never
+// re-quantized by the raw → display → raw round trip.
+
+int RosterEditor::apply_transform(RosterTransform& t) {
+    if (!t.compile()) return 0;
+    const auto& cols   = t.columns();
+    const auto& steps  = t.steps();
+    const auto& ranges = t.ranges();
+    const int   position_mask = t.position_mask();
+    const int   team_id = t.team_id();
+
+    auto read_value = [](const uint8_t* rec, const RosterTransform::Column& c) {
+        uint32_t raw = BitStream::peek_bits(rec, c.loc.bit_pos, c.loc.width);
+        return c.kind == FIELD_RATING ? static_cast<float>(Player::raw_to_display(static_cast<uint8_t>(raw)))
+                                      : static_cast<float>(raw);
+    };
+
+    // 1. Filter + gather
+    std::vector<int> rows;
+    std::vector<std::vector<float>> values(cols.size());
+    for (auto& v : values) v.reserve(static_cast<size_t>(player_count_));
+    for (int i = 0; i < player_count_; ++i) {
+        const uint8_t* rec = buffer_ + player_table_offset_ + static_cast<size_t>(i) * player_record_size_;
+        if (i == 0 || record_is_null(rec)) continue;   // Dummy slot and CAP/template records
+        if (position_mask >= 0) {
+            int pos = rec[VITAL_POSITION_OFFSET];
+            if (pos > 30 || !((position_mask >> pos) & 1)) continue;
+        }
+        if (team_id >= 0 && rec[VITAL_TEAM_ID1_OFFSET] != team_id) continue;
+        bool pass = true;
+        for (const auto& r : ranges) {
+            float v = read_value(rec, cols[r.column]);
+            if (v < r.lo || v > r.hi) { pass = false; break; }
+        }
+        if (!pass) continue;
+        rows.push_back(i);
+        for (size_t c = 0; c < cols.size(); ++c) values[c].push_back(read_value(rec, cols[c]));
+    }
+    if (rows.empty()) return 0;
+
+    // Keep the gathered values to detect which ones actually changed.
+    std::vector<std::vector<float>> before;
+    before.reserve(cols.size());
+    for (size_t c = 0; c < cols.size(); ++c) {
+        before.push_back(cols[c].written ? values[c] : std::vector<float>());
+    }
+
+    // 2. Column kernels
+    const size_t n = rows.size();
+    for (const auto& st : steps) {
+        float* dst = values[st.dst].data();
+        const float a = st.a, b = st.b;
+        switch (st.op) {
+            case RosterTransform::OP_SCALE:
+                for (size_t i = 0; i < n; ++i) dst[i] *= a;
+                break;
+            case RosterTransform::OP_ADD:
+                for (size_t i = 0; i < n; ++i) dst[i] += a;
+                break;
+            case RosterTransform::OP_CLAMP:
+                for (size_t i = 0; i < n; ++i) {
+                    float v = dst[i] < a ? a : dst[i];
+                    dst[i] = v > b ? b : v;
+                }
+                break;
+            case RosterTransform::OP_SET:
+                for (size_t i = 0; i < n; ++i) dst[i] = a;
+                break;
+            case RosterTransform::OP_COPY: {
+                const float* src = values[st.src].data();
+                for (size_t i = 0; i < n; ++i) dst[i] = src[i];
+                break;
+            }
+        }
+    }
+
+    // 3. Scatter
+    bool feeds_overall = false;
+    for (const auto& col : cols) {
+        if (col.written && col.kind == FIELD_RATING && col.id != RAT_OVERALL) feeds_overall = true;
+    }
+    int changed_players = 0;
+    for (size_t r = 0; r < n; ++r) {
+        size_t rec_off = player_table_offset_ + static_cast<size_t>(rows[r]) * player_record_size_;
+        bool changed = false;
+        for (size_t c = 0; c < cols.size(); ++c) {
+            const auto& col = cols[c];
+            if (!col.written) continue;
+            float v = std::min(std::max(std::nearbyint(values[c][r]), col.lo), col.hi);
+            if (v == before[c][r]) continue;
+            uint32_t raw = col.kind == FIELD_RATING ? Player::display_to_raw(static_cast<int>(v))
+                                                    : static_cast<uint32_t>(v);
+            note_write(rec_off + col.loc.bit_pos / 8, (col.loc.bit_pos % 8 + col.loc.width + 7) / 8);
+            BitStream::poke_bits(buffer_ + rec_off, col.loc.bit_pos, col.loc.width, raw);
+            changed = true;
+        }
+        if (changed) {
+            ++changed_players;
+            if (auto_overall_ && feeds_overall) recompute_overall(rows[r]);
+        }
+    }
+    return changed_players;
+}
+
+// -- Overall rating -----------------------------------------------------------
+// Full pass: bucket players by weight row, gather each bucket's ratings into
+// contiguous columns, then one multiply-add loop per (rating, bucket).
+
+int RosterEditor::recompute_overalls() {
+    const size_t n = static_cast<size_t>(player_count_);
+    if (n == 0) return 0;
+
+    // Counting sort of player indices by weight row. Slot 0 and null
+    // (CAP/template) records get no row and are left untouched.
+    static constexpr uint8_t NO_ROW = OverallModel::ROW_COUNT;
+    size_t bucket_start[OverallModel::ROW_COUNT + 1] = {};
+    std::vector<uint8_t> row_of(n);
+    for (size_t i = 0; i < n; ++i) {
+        const uint8_t* rec = buffer_ + player_table_offset_ + i * player_record_size_;
+        if (i == 0 || record_is_null(rec)) {
+            row_of[i] = NO_ROW;
+            continue;
+        }
+        row_of[i] = static_cast<uint8_t>(OverallModel::row_for(rec[VITAL_POSITION_OFFSET]));
+        ++bucket_start[row_of[i] + 1];
+    }
+    for (int r = 0; r < OverallModel::ROW_COUNT; ++r) bucket_start[r + 1] += bucket_start[r];
+    const size_t live = bucket_start[OverallModel::ROW_COUNT];
+    if (live == 0) return 0;
+    std::vector<int> order(live);
+    {
+        size_t fill[OverallModel::ROW_COUNT];
+        std::copy(bucket_start, bucket_start + OverallModel::ROW_COUNT, fill);
+        for (size_t i = 0; i < n; ++i) {
+            if (row_of[i] != NO_ROW) order[fill[row_of[i]]++] = static_cast<int>(i);
+        }
+    }
+
+    // Column-major ratings in bucket order.
+    std::vector<float> storage(live * RAT_COUNT);
+    const float* columns[RAT_COUNT];
+    for (int id = 0; id < RAT_COUNT; ++id) {
+        float* col = storage.data() + static_cast<size_t>(id) * live;
+        columns[id] = col;
+        for (size_t k = 0; k < live; ++k) {
+            const uint8_t* rec = buffer_ + player_table_offset_ + static_cast<size_t>(order[k]) * player_record_size_;
+            col[k] = static_cast<float>(Player::raw_to_display(rec[RATING_OFFSETS[id]]));
+        }
+    }
+
+    std::vector<float> result(live);
+    for (int r = 0; r < OverallModel::ROW_COUNT; ++r) {
+        size_t lo = bucket_start[r], hi = bucket_start[r + 1];
+        if (hi == lo) continue;
+        const float* bucket_columns[RAT_COUNT];
+        for (int id = 0; id < RAT_COUNT; ++id) bucket_columns[id] = columns[id] + lo;
+        overall_.evaluate_batch(bucket_columns, hi - lo, r, result.data() + lo);
+    }
+
+    int changed = 0;
+    for (size_t k = 0; k < live; ++k) {
+        size_t off = player_table_offset_ + static_cast<size_t>(order[k]) * player_record_size_ + RATING_OFFSETS[RAT_OVERALL];
+        int display = static_cast<int>(std::lround(result[k]));
+        if (display == static_cast<int>(columns[RAT_OVERALL][k])) continue;
+        note_write(off, 1);
+        buffer_[off] = Player::display_to_raw(display);
+        ++changed;
+    }
+    return changed;
+}
+
+int RosterEditor::compute_overall(int index) {
+    if (index < 0 || index >= player_count_) {
+        roster_fail(ROSTER_ERR_OUT_OF_RANGE, "RosterEditor::compute_overall: index out of range");
+        return 0;
+    }
+    const uint8_t* rec = buffer_ + player_table_offset_ + static_cast<size_t>(index) * player_record_size_;
+    float ratings[RAT_COUNT];
+    for (int id = 0; id < RAT_COUNT; ++id) {
+        ratings[id] = static_cast<float>(Player::raw_to_display(rec[RATING_OFFSETS[id]]));
+    }
+    return static_cast<int>(std::lround(overall_.evaluate(ratings, OverallModel::row_for(rec[VITAL_POSITION_OFFSET]))));
+}
+
+bool RosterEditor::recompute_overall(int index) {
+    int display = compute_overall(index);
+    size_t off = player_table_offset_ + static_cast<size_t>(index) * player_record_size_ + RATING_OFFSETS[RAT_OVERALL];
+    if (Player::raw_to_display(buffer_[off]) == display) return false;
+    note_write(off, 1);
+    buffer_[off] = Player::display_to_raw(display);
+    return true;
+}
+
+void RosterEditor::on_rating_changed(int index) {
+    if (auto_overall_ && index >= 0 && index < player_count_) recompute_overall(index);
+}
+
+void RosterEditor::set_auto_overall(bool enabled) {
+    auto_overall_ = enabled;
+}
+
+void RosterEditor::set_overall_weight(int position, int rating_id, double weight) {
+    overall_.set_weight(position, rating_id, weight);
+}
+
+double RosterEditor::get_overall_weight(int position, int rating_id) const {
+    return overall_.get_weight(position, rating_id);
+}
+
+void RosterEditor::reset_overall_weights() {
+    overall_.reset_defaults();
+}
+
+// -- Aggregate statistics -----------------------------------------------------
+
+bool RosterEditor::sample_stat(int kind, const FieldLoc& loc, int group_by, int index,
+                               int& group, int64_t& value) const {
+    const uint8_t* rec = buffer_ + player_table_offset_ + static_cast<size_t>(index) * player_record_size_;
+    if (record_is_null(rec)) return false;
+    uint32_t raw = BitStream::peek_bits(rec, loc.bit_pos, loc.width);
+    value = kind == FIELD_RATING ? Player::raw_to_display(static_cast<uint8_t>(raw)) : raw;
+
+    int team = rec[VITAL_TEAM_ID1_OFFSET];
+    int pos  = OverallModel::row_for(rec[VITAL_POSITION_OFFSET]);
+    switch (group_by) {
+        case STATS_BY_TEAM:          group = team; break;
+        case STATS_BY_POSITION:      group = pos; break;
+        case STATS_BY_TEAM_POSITION: group = team * OverallModel::ROW_COUNT + pos; break;
+        default:                     group = 0; break;
+    }
+    return true;
+}
+
+FieldAggregate* RosterEditor::aggregate(int kind, int id, int group_by) {
+    FieldLoc loc;
+    int groups = RosterStats::group_count(group_by);
+    if (!buffer_ || groups == 0 || !locate_player_field(kind, id, loc)) {
+        roster_fail(ROSTER_ERR_INVALID_ARGUMENT, "RosterEditor: unknown stats field or grouping");
+        return nullptr;
+    }
+
+    FieldAggregate* agg = stats_.find(kind, id, group_by);
+    if (!agg) {
+        int lo, hi;
+        player_field_domain(kind, id, lo, hi);
+        agg = stats_.insert(kind, id, group_by,
+                            std::unique_ptr<FieldAggregate>(new FieldAggregate(groups, lo, hi, player_count_)));
+        agg->mark_all_dirty();
+    }
+
+    // Re-sample written players (all of them, in order, on first use).
+    agg->drain_dirty([&](int i) {
+        int group;
+        int64_t value;
+        if (sample_stat(kind, loc, group_by, i, group, value)) agg->update(i, group, value);
+        else agg->update(i, FieldAggregate::NO_GROUP, 0);
+    });
+    return agg;
+}
+
+FieldLeaderboard* RosterEditor::leaderboard(int kind, int id, int group_by, int k) {
+    FieldLoc loc;
+    int groups = RosterStats::group_count(group_by);
+    if (!buffer_ || groups == 0 || !locate_player_field(kind, id, loc)) {
+        roster_fail(ROSTER_ERR_INVALID_ARGUMENT, "RosterEditor: unknown stats field or grouping");
+        return nullptr;
+    }
+
+    int group;
+    int64_t value;
+    FieldLeaderboard* board = stats_.find_board(kind, id, group_by);
+    if (!board || board->capacity() < std::min(k, FieldLeaderboard::MAX_K)) {
+        // First use (or a deeper board): sample everyone, then rank each
+        // group by partial selection in one pass.
+        board = stats_.insert_board(kind, id, group_by,
+                                    std::unique_ptr<FieldLeaderboard>(new FieldLeaderboard(groups, k, player_count_)));
+        for (int i = 0; i < player_count_; ++i) {
+            if (sample_stat(kind, loc, group_by, i, group, value)) board->assign(i, group, value);
+        }
+        board->rebuild();
+        return board;
+    }
+
+    board->drain_dirty([&](int i) {
+        if (sample_stat(kind, loc, group_by, i, group, value)) board->update(i, group, value);
+        else board->update(i, FieldLeaderboard::NO_GROUP, 0);
+    });
+    return board;
+}
+
+int RosterEditor::stats_summary(int kind, int id, int group_by, size_t out_ptr, int max_groups) {
+    FieldAggregate* agg = aggregate(kind, id, group_by);
+    if (!agg) return 0;
+    FieldAggregate::Summary* out = reinterpret_cast<FieldAggregate::Summary*>(out_ptr);
+    int found = 0;
+    for (int g = 0; g < agg->group_count(); ++g) {
+        FieldAggregate::Summary s;
+        if (!agg->summarize(g, s)) continue;
+        if (out && found < max_groups) out[found] = s;
+        ++found;
+    }
+    return found;
+}
+
+int RosterEditor::stats_histogram(int kind, int id, int group_by, int group, size_t out_ptr, int max_bins) {
+    FieldAggregate* agg = aggregate(kind, id, group_by);
+    if (!agg) return 0;
+    int32_t* out = reinterpret_cast<int32_t*>(out_ptr);
+    if (!out) return agg->bin_count();
+
+    out[0] = static_cast<int32_t>(agg->bin_lo());
+    out[1] = static_cast<int32_t>(agg->bin_width());
+    const uint32_t* bins = agg->histogram(group);
+    int n = std::min(agg->bin_count(), std::max(max_bins, 0));
+    for (int b = 0; b < n; ++b) out[2 + b] = bins ? static_cast<int32_t>(bins[b]) : 0;
+    return agg->bin_count();
+}
+
+int RosterEditor::stats_quantile(int kind, int id, int group_by, int group, double q) {
+    FieldAggregate* agg = aggregate(kind, id, group_by);
+    return agg ? static_cast<int>(agg->quantile(group, q)) : 0;
+}
+
+int RosterEditor::stats_top(int kind, int id, int group_by, int group, int k, size_t out_ptr) {
+    FieldLeaderboard::Entry* out = reinterpret_cast<FieldLeaderboard::Entry*>(out_ptr);
+    if (!out || k <= 0) return 0;
+    FieldLeaderboard* board = leaderboard(kind, id, group_by, k);
+    return board ? board->top(group, k, out) : 0;
+}
+
+// -- Roster diff --------------------------------------------------------------
+
+int RosterEditor::diff_players(size_t other_ptr, int other_length, size_t out_ptr, int max_results) {
+    const uint8_t* other = reinterpret_cast<const uint8_t*>(other_ptr);
+    uint32_t* out = reinterpret_cast<uint32_t*>(out_ptr);
+    if (!other || static_cast<size_t>(other_length) != buffer_length_) {
+        roster_fail(ROSTER_ERR_INVALID_ARGUMENT, "RosterEditor::diff_players: roster sizes differ");
+        return 0;
+    }
+
+    // Flag per record in parallel, then compact in index order.
+    std::vector<uint8_t> differs(static_cast<size_t>(player_count_));
+    TaskScheduler::shared().parallel_for(differs.size(), 64, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            size_t off = player_table_offset_ + i * player_record_size_;
+            differs[i] = std::memcmp(buffer_ + off, other + off, player_record_size_) != 0;
+        }
+    });
+
+    int found = 0;
+    for (int i = 0; i < player_count_; ++i) {
+        if (!differs[i]) continue;
+        if (out && found < max_results) out[found] = static_cast<uint32_t>(i);
+        ++found;
+    }
+    return found;
+}
+
+// XOR a word at a time; each set bit of the difference bumps the count for
+// its MSB-first record offset. Slices of the table build private heatmaps
+// on the worker pool that are summed at the end.
+int RosterEditor::bit_heatmap(const char* what, size_t other_ptr, int other_length, int table,
+                              std::vector<uint32_t>& counts) const {
+    const uint8_t* other = reinterpret_cast<const uint8_t*>(other_ptr);
+    if (!other || static_cast<size_t>(other_length) != buffer_length_) {
+        roster_fail(ROSTER_ERR_INVALID_ARGUMENT, std::string("RosterEditor::") + what + ": roster sizes differ");
+        return -1;
+    }
+    if (table != CHANGE_TABLE_PLAYER && table != CHANGE_TABLE_TEAM) {
+        roster_fail(ROSTER_ERR_INVALID_ARGUMENT, std::string("RosterEditor::") + what + ": unknown table");
+        return -1;
+    }
+    const bool players = table == CHANGE_TABLE_PLAYER;
+    const size_t offset = players ? player_table_offset_ : team_table_offset_;
+    const size_t size   = players ? player_record_size_  : team_record_size_;
+    const size_t count  = static_cast<size_t>(players ? player_count_ : team_count_);
+    const size_t bits   = size * 8;
+
+    const size_t slices = std::min<size_t>(count, static_cast<size_t>(TaskScheduler::shared().worker_count()) + 1);
+    std::vector<std::vector<uint32_t>> partial(slices);
+    std::vector<int> changed(slices, 0);
+    TaskScheduler::shared().parallel_for(slices, 1, [&](size_t begin, size_t end) {
+        for (size_t s = begin; s < end; ++s) {
+            std::vector<uint32_t>& heat = partial[s];
+            heat.assign(bits, 0);
+            for (size_t r = s * count / slices; r < (s + 1) * count / slices; ++r) {
+                const uint8_t* a = buffer_ + offset + r * size;
+                const uint8_t* b = other + offset + r * size;
+                bool differs = false;
+                size_t i = 0;
+                for (; i + 8 <= size; i += 8) {
+                    uint64_t wa, wb;
+                    std::memcpy(&wa, a + i, 8);
+                    std::memcpy(&wb, b + i, 8);
+                    uint64_t x = wa ^ wb;
+                    if (!x) continue;
+                    differs = true;
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+                    x = __builtin_bswap64(x);   // Byte i now in the top bits
+#endif
+                    while (x) {
+                        int lead = __builtin_clzll(x);
+                        ++heat[i * 8 + lead];
+                        x &= ~(uint64_t(1) << (63 - lead));
+                    }
+                }
+                for (; i < size; ++i) {
+                    uint8_t x = a[i] ^ b[i];
+                    if (!x) continue;
+                    differs = true;
+                    for (int bit = 0; bit < 8; ++bit) heat[i * 8 + bit] += (x >> (7 - bit)) & 1;
+                }
+                changed[s] += differs;
+            }
+        }
+    });
+
+    counts.assign(bits, 0);
+    int total = 0;
+    for (size_t s = 0; s < slices; ++s) {
+        for (size_t b = 0; b < bits; ++b) counts[b] += partial[s][b];
+        total += changed[s];
+    }
+    return total;
+}
+
+int RosterEditor::diff_bit_heatmap(size_t other_ptr, int other_length, int table, size_t out_ptr) {
+    std::vector<uint32_t> counts;
+    int changed = bit_heatmap("diff_bit_heatmap", other_ptr, other_length, table, counts);
+    if (changed < 0) return 0;
+    if (out_ptr) std::copy(counts.begin(), counts.end(), reinterpret_cast<uint32_t*>(out_ptr));
+    return changed;
+}
+
+int RosterEditor::diff_bit_runs(size_t other_ptr, int other_length, int table, int min_records,
+                                size_t out_ptr, int max_runs) {
+    std::vector<uint32_t> counts;
+    if (bit_heatmap("diff_bit_runs", other_ptr, other_length, table, counts) < 0) return 0;
+
+    const uint32_t threshold = static_cast<uint32_t>(std::max(min_records, 1));
+    std::vector<BitDiffRun> runs;
+    for (size_t b = 0; b < counts.size(); ) {
+        if (counts[b] < threshold) { ++b; continue; }
+        BitDiffRun run = { static_cast<uint32_t>(b), 0, counts[b], counts[b] };
+        for (; b < counts.size() && counts[b] >= threshold; ++b) {
+            ++run.width;
+            run.min_records = std::min(run.min_records, counts[b]);
+            run.max_records = std::max(run.max_records, counts[b]);
+        }
+        runs.push_back(run);
+    }
+
+    BitDiffRun* out = reinterpret_cast<BitDiffRun*>(out_ptr);
+    if (out && max_runs > 0) {
+        size_t n = std::min(runs.size(), static_cast<size_t>(max_runs));
+        std::partial_sort(runs.begin(), runs.begin() + n, runs.end(),
+            [](const BitDiffRun& a, const BitDiffRun& b) {
+                return a.max_records != b.max_records ? a.max_records > b.max_records : a.bit_pos < b.bit_pos;
+            });
+        std::copy(runs.begin(), runs.begin() + n, out);
+    }
+    return static_cast<int>(runs.size());
+}
+
+// -- Field discovery ----------------------------------------------------------
+
+int RosterEditor::find_field(FieldSearch& search, size_t out_ptr, int max_results) {
+    if (!buffer_) {
+        roster_fail(ROSTER_ERR_NO_BUFFER, "RosterEditor: no buffer loaded");
+        return 0;
+    }
+    return search.run(buffer_ + player_table_offset_, player_record_size_, player_count_,
+                      reinterpret_cast<FieldSearch::Candidate*>(out_ptr), max_results);
+}
+
+// -- Similarity search --------------------------------------------------------
+
+static_assert(PlayerVectors::RATING_DIMS == RAT_COUNT && PlayerVectors::TENDENCY_DIMS == TEND_COUNT,
+              "PlayerVectors dimensions must match the rating and tendency tables");
+
+int RosterEditor::find_similar(SimilaritySearch& search, int player, size_t out_ptr, int max_results) {
+    if (!buffer_) {
+        roster_fail(ROSTER_ERR_NO_BUFFER, "RosterEditor: no buffer loaded");
+        return 0;
+    }
+
+    vectors_.refresh([&](int i, float* values, PlayerVectors::Meta& meta) {
+        const uint8_t* rec = buffer_ + player_table_offset_ + static_cast<size_t>(i) * player_record_size_;
+        meta.live = !record_is_null(rec);
+        meta.team = rec[VITAL_TEAM_ID1_OFFSET];
+        meta.row  = static_cast<uint8_t>(OverallModel::row_for(rec[VITAL_POSITION_OFFSET]));
+        for (int id = 0; id < RAT_COUNT; ++id) {
+            values[id] = static_cast<float>(Player::raw_to_display(rec[RATING_OFFSETS[id]]));
+        }
+        FieldLoc loc;
+        for (int id = 0; id < TEND_COUNT; ++id) {
+            locate_player_field(FIELD_TENDENCY, id, loc);
+            values[RAT_COUNT + id] = static_cast<float>(BitStream::peek_bits(rec, loc.bit_pos, loc.width));
+        }
+    });
+    return search.run(vectors_, player, reinterpret_cast<SimilaritySearch::Match*>(out_ptr), max_results);
+}
+
+// -- Roster balancing ---------------------------------------------------------
+// Entries are the counted (non-null, position-passing) players on selected
+// team rosters. A player listed on two selected teams still counts for both
+// but is never moved: adjusting it would shift two averages at once.
+
+int RosterEditor::plan_balance(RosterBalancer& balancer) {
+    balancer.clear_plan();
+    if (!buffer_) {
+        roster_fail(ROSTER_ERR_NO_BUFFER, "RosterEditor: no buffer loaded");
+        return 0;
+    }
+    if (team_count_ == 0) {
+        roster_fail(ROSTER_ERR_NO_BUFFER, "RosterEditor::plan_balance: no team table");
+        return 0;
+    }
+    FieldLoc loc;
+    const int kind = balancer.field_kind();
+    locate_player_field(kind, balancer.field_id(), loc);
+    int lo, hi;
+    player_field_domain(kind, balancer.field_id(), lo, hi);
+
+    std::vector<RosterBalancer::Entry> entries;
+    std::vector<uint8_t> listings(static_cast<size_t>(player_count_), 0);
+    for (int t = 0; t < team_count_; ++t) {
+        if (!balancer.wants_team(t)) continue;
+        const uint8_t* team = buffer_ + team_table_offset_ + static_cast<size_t>(t) * team_record_size_;
+        for (int s = 0; s < Team::ROSTER_SLOTS; ++s) {
+            const uint8_t* slot = team + TEAM_ROSTER_OFFSET + s * 2;
+            int p = slot[0] | (slot[1] << 8);
+            if (p == Team::ROSTER_EMPTY || p == 0 || p >= player_count_) continue;
+            const uint8_t* rec = buffer_ + player_table_offset_ + static_cast<size_t>(p) * player_record_size_;
+            if (record_is_null(rec) || !balancer.counts_position(rec[VITAL_POSITION_OFFSET])) continue;
+
+            uint32_t raw = BitStream::peek_bits(rec, loc.bit_pos, loc.width);
+            int value = kind == FIELD_RATING ? Player::raw_to_display(static_cast<uint8_t>(raw)) : static_cast<int>(raw);
+            entries.push_back({ t, s, p, value, OverallModel::row_for(rec[VITAL_POSITION_OFFSET]),
+                                !balancer.is_locked(p) });
+            if (listings[p] < 2) ++listings[p];
+        }
+    }
+    for (RosterBalancer::Entry& e : entries) e.movable = e.movable && listings[e.player] == 1;
+    return balancer.solve(std::move(entries), lo, hi);
+}
+
+int RosterEditor::apply_balance(RosterBalancer& balancer) {
+    if (!buffer_) {
+        roster_fail(ROSTER_ERR_NO_BUFFER, "RosterEditor: no buffer loaded");
+        return 0;
+    }
+    if (!balancer.has_plan()) {
+        roster_fail(ROSTER_ERR_INVALID_ARGUMENT, "RosterEditor::apply_balance: no plan (call plan_balance)");
+        return 0;
+    }
+    FieldLoc loc;
+    const int kind = balancer.field_kind();
+    locate_player_field(kind, balancer.field_id(), loc);
+    int lo, hi;
+    player_field_domain(kind, balancer.field_id(), lo, hi);
+
+    auto record_offset = [this](int player) {
+        return player_table_offset_ + static_cast<size_t>(player) * player_record_size_;
+    };
+    auto read_value = [&](int player) {
+        uint32_t raw = BitStream::peek_bits(buffer_ + record_offset(player), loc.bit_pos, loc.width);
+        return kind == FIELD_RATING ? Player::raw_to_display(static_cast<uint8_t>(raw)) : static_cast<int>(raw);
+    };
+
+    // The plan is only valid against the rosters and values it was solved on.
+    const auto& entries = balancer.entries();
+    for (const RosterBalancer::Entry& e : entries) {
+        bool same = e.team < team_count_ && e.player < player_count_;
+        if (same) {
+            const uint8_t* slot = buffer_ + team_table_offset_ + static_cast<size_t>(e.team) * team_record_size_
+                                + TEAM_ROSTER_OFFSET + e.slot * 2;
+            same = (slot[0] | (slot[1] << 8)) == e.player && read_value(e.player) == e.value;
+        }
+        if (!same) {
+            balancer.clear_plan();
+            roster_fail(ROSTER_ERR_INVALID_ARGUMENT, "RosterEditor::apply_balance: roster changed since the plan");
+            return 0;
+        }
+    }
+
+    for (const RosterBalancer::Placement& pl : balancer.placements()) {
+        get_team(pl.team).set_roster_player_id(pl.slot, entries[pl.entry].player);
+    }
+    const bool feeds_overall = kind == FIELD_RATING && balancer.field_id() != RAT_OVERALL;
+    for (const RosterBalancer::Change& c : balancer.changes()) {
+        size_t rec_off = record_offset(c.player);
+        if (c.to_team != c.from_team) {
+            // Both team ids, like every other trade path.
+            const uint8_t team_id = buffer_[team_table_offset_ + static_cast<size_t>(c.to_team) * team_record_size_];
+            note_write(rec_off + VITAL_TEAM_ID1_OFFSET, 1);
+            buffer_[rec_off + VITAL_TEAM_ID1_OFFSET] = team_id;
+            note_write(rec_off + VITAL_TEAM_ID2_OFFSET, 1);
+            buffer_[rec_off + VITAL_TEAM_ID2_OFFSET] = team_id;
+        }
+        if (c.delta == 0) continue;
+        int v = std::min(std::max(read_value(c.player) + c.delta, lo), hi);
+        uint32_t raw = kind == FIELD_RATING ? Player::display_to_raw(v) : static_cast<uint32_t>(v);
+        note_write(rec_off + loc.bit_pos / 8, (loc.bit_pos % 8 + loc.width + 7) / 8);
+        BitStream::poke_bits(buffer_ + rec_off, loc.bit_pos, loc.width, raw);
+        if (auto_overall_ && feeds_overall) recompute_overall(c.player);
+    }
+    int written = balancer.get_change_count();
+    balancer.clear_plan();
+    return written;
+}
+
+// -- Integrity scan -----------------------------------------------------------
+// Pass 1 walks the team rosters and records, per player slot, the first team
+// that lists it; a second listing is a duplicate. Pass 2 walks the player
+// table once, checking CFIDs (a 64K-bit set), the vital ranges below, and
+// VITAL_TEAM_ID1 against the roster ownership from pass 1.
+
+struct VitalRange {
+    int      vital;
+    uint32_t bit_pos;   // MSB-first, from the record start
+    int      width;
+    int      lo, hi;
+};
+
+// Only fields whose legal domain is narrower than their storage.
+static constexpr VitalRange VITAL_RANGES[] = {
+    { VITAL_POSITION,    33 * 8,     8, 0,  4 },
+    { VITAL_BIRTH_DAY,   37 * 8,     8, 1, 31 },
+    { VITAL_BIRTH_MONTH, 38 * 8,     8, 1, 12 },
+    { VITAL_HAND,        41 * 8,     8, 0,  1 },
+    { VITAL_JERSEY_NUM,  13 * 8 + 4, 8, 0, 99 },
+    { VITAL_DRAFT_ROUND, 49 * 8,     4, 0,  2 },
+    { VITAL_DRAFT_PICK,  49 * 8 + 4, 6, 0, 30 },
+};
+
+class IssueWriter {
+public:
+    IssueWriter(RosterIssue* out, int max) : out_(out), max_(out ? max : 0), count_(0) {}
+    void add(IssueCode code, int detail, int team, int player) {
+        if (count_ < max_) {
+            out_[count_] = { static_cast<uint16_t>(code), static_cast<uint16_t>(detail),
+                             static_cast<uint16_t>(team), static_cast<uint16_t>(player) };
+        }
+        ++count_;
+    }
+    int count() const { return count_; }
+private:
+    RosterIssue* out_;
+    int max_;
+    int count_;
+};
+
+int RosterEditor::validate(size_t out_ptr, int max_issues) {
+    IssueWriter issues(reinterpret_cast<RosterIssue*>(out_ptr), max_issues);
+    if (!buffer_) return 0;
+
+    auto record = [this](int index) {
+        return buffer_ + player_table_offset_ + static_cast<size_t>(index) * player_record_size_;
+    };
+
+    // Pass 1: roster ownership. owner[p] = first team listing player p.
+    constexpr uint8_t NO_OWNER = 0xFF;
+    std::vector<uint8_t> owner(static_cast<size_t>(player_count_), NO_OWNER);
+    int team_of_id[256];
+    std::fill(team_of_id, team_of_id + 256, -1);
+
+    for (int t = 0; t < team_count_; ++t) {
+        const uint8_t* team = buffer_ + team_table_offset_ + static_cast<size_t>(t) * team_record_size_;
+        if (team_of_id[team[0]] < 0) team_of_id[team[0]] = t;
+        for (int s = 0; s < Team::ROSTER_SLOTS; ++s) {
+            const uint8_t* slot = team + TEAM_ROSTER_OFFSET + s * 2;
+            int p = slot[0] | (slot[1] << 8);
+            if (p == Team::ROSTER_EMPTY || p == 0) continue;
+            if (p >= player_count_ || record_is_null(record(p))) {
+                issues.add(ISSUE_BAD_ROSTER_SLOT, s, t, p);
+            } else if (owner[p] != NO_OWNER) {
+                issues.add(ISSUE_DUPLICATE_ROSTER_SLOT, s, t, p);
+            } else {
+                owner[p] = static_cast<uint8_t>(t);
+            }
+        }
+    }
+
+    // Pass 2: one sweep over the player table.
+    std::vector<uint64_t> cfid_seen(65536 / 64, 0);
+    for (int p = 0; p < player_count_; ++p) {
+        const uint8_t* rec = record(p);
+        if (record_is_null(rec)) continue;
+
+        uint16_t cfid = static_cast<uint16_t>(rec[CFID_OFFSET] | (rec[CFID_OFFSET + 1] << 8));
+        if (test_bit(cfid_seen, cfid)) issues.add(ISSUE_DUPLICATE_CFID, cfid, ISSUE_NO_TEAM, p);
+        set_bit(cfid_seen, cfid);
+
+        for (const VitalRange& r : VITAL_RANGES) {
+            int v = static_cast<int>(BitStream::peek_bits(rec, r.bit_pos, r.width));
+            if (v < r.lo || v > r.hi) issues.add(ISSUE_FIELD_RANGE, r.vital, ISSUE_NO_TEAM, p);
+        }
+
+        // Team consistency needs a discovered team table.
+        if (team_count_ == 0) continue;
+        int team_id = rec[VITAL_TEAM_ID1_OFFSET];
+        if (owner[p] != NO_OWNER) {
+            const uint8_t* team = buffer_ + team_table_offset_ + owner[p] * team_record_size_;
+            if (team_id != team[0]) issues.add(ISSUE_TEAM_ID_MISMATCH, team_id, owner[p], p);
+        } else if (team_id != FREE_AGENT_TEAM_ID && team_of_id[team_id] >= 0) {
+            // Claims a team whose roster does not list it.
+            issues.add(ISSUE_TEAM_ID_MISMATCH, team_id, ISSUE_NO_TEAM, p);
+        }
+    }
+    return issues.count();
+}
+
+// -- Synthetic players --------------------------------------------------------
+// One scan of the table collects the donor pools (live players by position,
+// slot 0 and unknown positions excluded), another the unused CFIDs;
+// archetypes are fitted only for the rows a request draws from. Each record
+// is assembled in a scratch buffer — base donor, names, gear, signature
+// skills, animations, hot zones, sampled ratings/tendencies/body, vitals,
+// CFID, overall — and reaches the table as one note_write and one memcpy.
+
+static constexpr int GENERATED_BIRTH_DAYS = 28;   // Valid in every month
+
+// Archetype vector of one record (PlayerGenerator layout).
+static void sample_archetype_vector(const uint8_t* rec, float* out) {
+    for (int id = 1; id < RAT_COUNT; ++id) {
+        out[id - 1] = static_cast<float>(Player::raw_to_display(rec[RATING_OFFSETS[id]]));
+    }
+    FieldLoc loc;
+    for (int id = 0; id < TEND_COUNT; ++id) {
+        locate_player_field(FIELD_TENDENCY, id, loc);
+        out[PlayerGenerator::RATING_DIMS + id] = static_cast<float>(BitStream::peek_bits(rec, loc.bit_pos, loc.width));
+    }
+    out[PlayerGenerator::HEIGHT_DIM] = rec[VITAL_HEIGHT_OFFSET];
+    out[PlayerGenerator::WEIGHT_DIM] = rec[VITAL_WEIGHT_OFFSET];
+}
+
+static void copy_player_field(uint8_t* to, const uint8_t* from, int kind, int id) {
+    FieldLoc loc;
+    if (locate_player_field(kind, id, loc)) {
+        BitStream::poke_bits(to, loc.bit_pos, loc.width, BitStream::peek_bits(from, loc.bit_pos, loc.width));
+    }
+}
+
+static_assert(PlayerGenerator::RATING_DIMS == RAT_COUNT - 1 && PlayerGenerator::TENDENCY_DIMS == TEND_COUNT,
+              "PlayerGenerator dimensions must match the rating and tendency tables");
+
+int RosterEditor::generate_players(PlayerGenerator& generator, int count, size_t out_ptr) {
+    if (!buffer_) {
+        roster_fail(ROSTER_ERR_NO_BUFFER, "RosterEditor: no buffer loaded");
+        return 0;
+    }
+    if (count < 0) {
+        roster_fail(ROSTER_ERR_INVALID_ARGUMENT, "RosterEditor::generate_players: negative count");
+        return 0;
+    }
+    if (count > get_free_slot_count()) {
+        roster_fail(ROSTER_ERR_OUT_OF_RANGE, "RosterEditor::generate_players: not enough free player slots");
+        return 0;
+    }
+    if (count == 0) return 0;
+
+    auto record_at = [this](int i) {
+        return buffer_ + player_table_offset_ + static_cast<size_t>(i) * player_record_size_;
+    };
+
+    std::vector<int> pools[OverallModel::POSITION_COUNT];
+    std::vector<int> live;
+    for (int i = 1; i < player_count_; ++i) {
+        const uint8_t* rec = record_at(i);
+        if (record_is_null(rec) || rec[VITAL_POSITION_OFFSET] >= OverallModel::POSITION_COUNT) continue;
+        pools[rec[VITAL_POSITION_OFFSET]].push_back(i);
+        live.push_back(i);
+    }
+    const std::vector<int>& base_pool = generator.position() < 0 ? live : pools[generator.position()];
+    if (base_pool.empty()) {
+        roster_fail(ROSTER_ERR_INVALID_ARGUMENT, "RosterEditor::generate_players: no live players to learn from");
+        return 0;
+    }
+
+    // Every CFID is reserved up front, so a shortfall writes nothing.
+    std::vector<uint16_t> cfids;
+    if (!unused_cfids(generator.cfid_base(), count, cfids)) {
+        roster_fail(ROSTER_ERR_OUT_OF_RANGE, "RosterEditor::generate_players: not enough unused CFIDs");
+        return 0;
+    }
+
+    RandomStream rng(generator.seed());
+    generator.clear_archetypes();
+    std::vector<float> samples;
+    std::vector<uint8_t> scratch(player_record_size_);
+    float values[PlayerGenerator::DIMS];
+    float ratings[RAT_COUNT];
+    int32_t* out = reinterpret_cast<int32_t*>(out_ptr);
+    const int hot_zones  = player_field_count(FIELD_HOT_ZONE);
+    const int sig_skills = player_field_count(FIELD_SIG_SKILL);
+    int rating_lo, rating_hi, tendency_lo, tendency_hi;
+    player_field_domain(FIELD_RATING, RAT_OVERALL, rating_lo, rating_hi);
+    player_field_domain(FIELD_TENDENCY, 0, tendency_lo, tendency_hi);
+
+    for (int n = 0; n < count; ++n) {
+        const uint8_t* base = record_at(base_pool[rng.below(static_cast<uint32_t>(base_pool.size()))]);
+        const int row = base[VITAL_POSITION_OFFSET];
+        const std::vector<int>& pool = pools[row];
+        auto donor = [&]() { return record_at(pool[rng.below(static_cast<uint32_t>(pool.size()))]); };
+        if (!generator.has_archetype(row)) {
+            samples.resize(pool.size() * PlayerGenerator::DIMS);
+            for (size_t k = 0; k < pool.size(); ++k) {
+                sample_archetype_vector(record_at(pool[k]), samples.data() + k * PlayerGenerator::DIMS);
+            }
+            generator.fit(row, samples.data(), static_cast<int>(pool.size()));
+        }
+
+        uint8_t* rec = scratch.data();
+        std::memcpy(rec, base, player_record_size_);
+
+        const uint8_t* first = record_at(live[rng.below(static_cast<uint32_t>(live.size()))]);
+        const uint8_t* last  = record_at(live[rng.below(static_cast<uint32_t>(live.size()))]);
+        std::memcpy(rec + FIRST_NAME_OFFSET, first + FIRST_NAME_OFFSET, 2);
+        std::memcpy(rec + LAST_NAME_OFFSET, last + LAST_NAME_OFFSET, 2);
+
+        const uint8_t* gear = donor();
+        for (int id = 0; id < GEAR_COUNT; ++id) copy_player_field(rec, gear, FIELD_GEAR, id);
+        const uint8_t* skills = donor();
+        for (int id = 0; id < sig_skills; ++id) copy_player_field(rec, skills, FIELD_SIG_SKILL, id);
+        for (int id = 0; id < ANIM_COUNT; ++id) copy_player_field(rec, donor(), FIELD_ANIMATION, id);
+        for (int id = 0; id < hot_zones; ++id) copy_player_field(rec, donor(), FIELD_HOT_ZONE, id);
+
+        generator.sample(row, rng, values);
+        ratings[RAT_OVERALL] = 0.0f;
+        for (int id = 1; id < RAT_COUNT; ++id) {
+            int v = std::min(std::max(static_cast<int>(std::lround(values[id - 1])), rating_lo), rating_hi);
+            ratings[id] = static_cast<float>(v);
+            rec[RATING_OFFSETS[id]] = Player::display_to_raw(v);
+        }
+        FieldLoc loc;
+        for (int id = 0; id < TEND_COUNT; ++id) {
+            int v = static_cast<int>(std::lround(values[PlayerGenerator::RATING_DIMS + id]));
+            locate_player_field(FIELD_TENDENCY, id, loc);
+            BitStream::poke_bits(rec, loc.bit_pos, loc.width,
+                                 static_cast<uint32_t>(std::min(std::max(v, tendency_lo), tendency_hi)));
+        }
+        rec[VITAL_HEIGHT_OFFSET] = static_cast<uint8_t>(std::min(std::max(
+            static_cast<int>(std::lround(values[PlayerGenerator::HEIGHT_DIM])), 0), 255));
+        rec[VITAL_WEIGHT_OFFSET] = static_cast<uint8_t>(std::min(std::max(
+            static_cast<int>(std::lround(values[PlayerGenerator::WEIGHT_DIM])), 0), 255));
+        int overall = static_cast<int>(std::lround(overall_.evaluate(ratings, row)));
+        rec[RATING_OFFSETS[RAT_OVERALL]] = Player::display_to_raw(std::min(std::max(overall, rating_lo), rating_hi));
+
+        rec[VITAL_BIRTH_OFFSET]     = static_cast<uint8_t>(1 + rng.below(GENERATED_BIRTH_DAYS));
+        rec[VITAL_BIRTH_OFFSET + 1] = static_cast<uint8_t>(1 + rng.below(12));
+        if (generator.first_birth_year() > 0) {
+            uint32_t span = static_cast<uint32_t>(generator.last_birth_year() - generator.first_birth_year() + 1);
+            int year = generator.first_birth_year() + static_cast<int>(rng.below(span));
+            rec[VITAL_BIRTH_OFFSET + 2] = static_cast<uint8_t>(year & 0xFF);
+            rec[VITAL_BIRTH_OFFSET + 3] = static_cast<uint8_t>(year >> 8);
+        }
+        BitStream::poke_bits(rec, VITAL_JERSEY_BIT, 8, rng.below(100));
+        for (const VitalRange& r : VITAL_RANGES) {   // Donor junk never passes on
+            int v = static_cast<int>(BitStream::peek_bits(rec, r.bit_pos, r.width));
+            if (v < r.lo || v > r.hi) BitStream::poke_bits(rec, r.bit_pos, r.width, static_cast<uint32_t>(r.lo));
+        }
+        rec[VITAL_TEAM_ID1_OFFSET] = FREE_AGENT_TEAM_ID;
+        rec[VITAL_TEAM_ID2_OFFSET] = FREE_AGENT_TEAM_ID;
+        rec[CFID_OFFSET]     = static_cast<uint8_t>(cfids[n] & 0xFF);
+        rec[CFID_OFFSET + 1] = static_cast<uint8_t>(cfids[n] >> 8);
+
+        // Free slots are named by no roster, so only the record changes.
+        int index = allocate_player_slot();
+        uint8_t* to = record_at(index);
+        change_name_refs(index, false);
+        note_write(static_cast<size_t>(to - buffer_), player_record_size_);
+        std::memcpy(to, rec, player_record_size_);
+        change_name_refs(index, true);
+        refresh_slot(index);
+        reindex_player(index);
+        if (out) out[n] = index;
+    }
+    return count;
+}
+
+// -- Background tasks ---------------------------------------------------------
+
+int RosterEditor::init_async(size_t buffer_ptr, int buffer_length) {
+    return TaskScheduler::shared().submit([this, buffer_ptr, buffer_length] {
+        init(buffer_ptr, buffer_length);
+        return player_count_;
+    });
+}
+
+int RosterEditor::load_prepared_async() {
+    return TaskScheduler::shared().submit([this] {
+        load_prepared();
+        return player_count_;
+    });
+}
+
+int RosterEditor::checksum_async() {
+    return TaskScheduler::shared().submit([this] {
+        save_and_recalculate_checksum();
+        return 0;
+    });
+}
+
+int RosterEditor::export_async(size_t out_ptr) {
+    return TaskScheduler::shared().submit([this, out_ptr] {
+        uint8_t* out = reinterpret_cast<uint8_t*>(out_ptr);
+        if (!out) {
+            roster_fail(ROSTER_ERR_INVALID_ARGUMENT, "RosterEditor::export_async: null output");
+            return 0;
+        }
+        save_and_recalculate_checksum();
+        TaskScheduler::shared().parallel_for(buffer_length_, CRC_SLICE, [&](size_t begin, size_t end) {
+            std::memcpy(out + begin, buffer_ + begin, end - begin);
+        });
+        return static_cast<int>(buffer_length_);
+    });
+}
+
+int RosterEditor::diff_players_async(size_t other_ptr, int other_length, size_t out_ptr, int max_results) {
+    return TaskScheduler::shared().submit([this, other_ptr, other_length, out_ptr, max_results] {
+        return diff_players(other_ptr, other_length, out_ptr, max_results);
+    });
+}
+
+int RosterEditor::plan_balance_async(RosterBalancer& balancer) {
+    return TaskScheduler::shared().submit([this, &balancer] {
+        return plan_balance(balancer);
+    });
+}
+
+bool RosterEditor::is_task_done(int handle) const {
+    return TaskScheduler::shared().is_done(handle);
+}
+
+int RosterEditor::wait_task(int handle) {
+    return TaskScheduler::shared().wait(handle);
+}
+
+int RosterEditor::get_worker_count() {
+    return TaskScheduler::shared().worker_count();
 }
 
 // -- CRC32 Checksum -----------------------------------------------------------
@@ -814,17 +2802,39 @@ Team RosterEditor::get_team(int index) const {
 //   2. Byte-swap the result (Big-Endian → Little-Endian)
 //   3. Overwrite the first 4 bytes with the swapped CRC
 
+// The payload is hashed in CRC_SLICE pieces on the worker pool and the
+// partial CRCs are merged with crc32_combine — identical to one sequential
+// pass.
+
 void RosterEditor::save_and_recalculate_checksum() {
     if (!buffer_ || buffer_length_ < 8) {
-        throw std::runtime_error("RosterEditor: no buffer loaded");
+        roster_fail(ROSTER_ERR_NO_BUFFER, "RosterEditor: no buffer loaded");
+        return;
     }
 
     // 1. Calculate CRC32 on payload (bytes 4 through end)
+    const uint8_t* payload = buffer_ + 4;
+    size_t payload_length = buffer_length_ - 4;
+    size_t slices = (payload_length + CRC_SLICE - 1) / CRC_SLICE;
+    std::vector<uLong> partial(slices);
+    TaskScheduler::shared().parallel_for(slices, 1, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            size_t lo = i * CRC_SLICE;
+            size_t n  = std::min(CRC_SLICE, payload_length - lo);
+            partial[i] = crc32(crc32(0L, Z_NULL, 0), payload + lo, static_cast<uInt>(n));
+        }
+    });
+
     uLong crc = crc32(0L, Z_NULL, 0);
-    crc = crc32(crc, buffer_ + 4, static_cast<uInt>(buffer_length_ - 4));
+    for (size_t i = 0; i < slices; ++i) {
+        size_t n = std::min(CRC_SLICE, payload_length - i * CRC_SLICE);
+        crc = crc32_combine(crc, partial[i], static_cast<z_off_t>(n));
+    }
+    write_checksum(static_cast<uint32_t>(crc));
+}
 
+void RosterEditor::write_checksum(uint32_t crc_value) {
     // 2. Byte-swap: convert to the expected endianness
-    uint32_t crc_value = static_cast<uint32_t>(crc);
 #if defined(__GNUC__) || defined(__clang__)
     uint32_t swapped = __builtin_bswap32(crc_value);
 #else
@@ -835,12 +2845,52 @@ void RosterEditor::save_and_recalculate_checksum() {
 #endif
 
     // 3. Write the swapped CRC32 into the first 4 bytes (Little-Endian)
+    note_write(0, 4);
     buffer_[0] = static_cast<uint8_t>( swapped        & 0xFF);
     buffer_[1] = static_cast<uint8_t>((swapped >>  8) & 0xFF);
     buffer_[2] = static_cast<uint8_t>((swapped >> 16) & 0xFF);
     buffer_[3] = static_cast<uint8_t>((swapped >> 24) & 0xFF);
 }
 
+// -- Streaming export ---------------------------------------------------------
+// Same CRC as save_and_recalculate_checksum, accumulated one chunk at a time
+// in file order. Chunk 0 hashes only its bytes past the 4-byte header.
+
+int RosterEditor::begin_export(int chunk_size) {
+    export_chunk_size_ = export_pos_ = export_len_ = 0;
+    if (!buffer_ || buffer_length_ < 8) {
+        roster_fail(ROSTER_ERR_NO_BUFFER, "RosterEditor: no buffer loaded");
+        return 0;
+    }
+    if (chunk_size <= 0) {
+        roster_fail(ROSTER_ERR_INVALID_ARGUMENT, "RosterEditor::begin_export: chunk size must be positive");
+        return 0;
+    }
+    export_chunk_size_ = static_cast<size_t>(chunk_size);
+    export_crc_ = crc32(0L, Z_NULL, 0);
+    return static_cast<int>((buffer_length_ + export_chunk_size_ - 1) / export_chunk_size_);
+}
+
+int RosterEditor::next_export_chunk() {
+    if (export_chunk_size_ == 0) return 0;   // No export in progress
+    export_pos_ += export_len_;
+    if (export_pos_ >= buffer_length_) {
+        export_chunk_size_ = export_pos_ = export_len_ = 0;
+        return 0;
+    }
+
+    export_len_ = std::min(export_chunk_size_, buffer_length_ - export_pos_);
+    size_t lo = std::max<size_t>(export_pos_, 4);
+    size_t hi = export_pos_ + export_len_;
+    if (hi > lo) export_crc_ = crc32(export_crc_, buffer_ + lo, static_cast<uInt>(hi - lo));
+    if (hi == buffer_length_) write_checksum(static_cast<uint32_t>(export_crc_));
+    return static_cast<int>(export_len_);
+}
+
+size_t RosterEditor::get_export_chunk_ptr() const {
+    return reinterpret_cast<size_t>(buffer_ + export_pos_);
+}
+
 size_t RosterEditor::get_buffer_ptr() const {
     return reinterpret_cast<size_t>(buffer_);
 }
@@ -4,8 +4,19 @@
 // ============================================================================
 
 #include "BitStream.hpp"
+#include "ChangeFeed.hpp"
+#include "NameTable.hpp"
+#include "SearchIndex.hpp"
+#include "SnapshotStore.hpp"
+#include "MappedFile.hpp"
+#include "OverallModel.hpp"
+#include "RosterStats.hpp"
+#include "RosterStatus.hpp"
+#include "SimilaritySearch.hpp"
+#include "TaskScheduler.hpp"
 #include <cstdint>
 #include <cstddef>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -278,10 +289,79 @@ enum GearID {
     GEAR_COUNT              // 48
 };
 
+// Field families that can be addressed generically by (kind, id), e.g. by
+// RosterTransform. Values are in the units the Player accessors use.
+enum FieldKind {
+    FIELD_RATING = 0,   // RatingID, display units 25..110
+    FIELD_TENDENCY,     // TendencyID, 0..127 (category flag bit untouched)
+    FIELD_ANIMATION,    // AnimationID, 0..255
+    FIELD_HOT_ZONE,     // Zone 0..13, 0..3
+    FIELD_SIG_SKILL,    // Slot 0..4, 0..63
+    FIELD_GEAR,         // GearID, raw bits
+    FIELD_KIND_COUNT
+};
+
+// Where a field lives inside a player record.
+struct FieldLoc {
+    uint32_t bit_pos;   // MSB-first bit position from the record start
+    int      width;     // In bits
+};
+
+bool locate_player_field(int kind, int id, FieldLoc& out);
+int  player_field_count(int kind);
+void player_field_domain(int kind, int id, int& lo, int& hi);
+
+// Problems reported by RosterEditor::validate.
+enum IssueCode {
+    ISSUE_DUPLICATE_ROSTER_SLOT = 1,   // Player listed on more than one roster slot
+    ISSUE_BAD_ROSTER_SLOT,             // Slot points past the table or at a null record
+    ISSUE_TEAM_ID_MISMATCH,            // VITAL_TEAM_ID1 disagrees with the team rosters
+    ISSUE_FIELD_RANGE,                 // Packed field holds a value outside its domain
+    ISSUE_DUPLICATE_CFID               // Two live players share a Cyberface ID
+};
+
+// One validate() result, 8 bytes so JS can read it as a Uint16Array.
+//   ISSUE_DUPLICATE_ROSTER_SLOT  detail = roster slot
+//   ISSUE_BAD_ROSTER_SLOT        detail = roster slot, player = stored value
+//   ISSUE_TEAM_ID_MISMATCH       detail = stored team id (team = rostering team, if any)
+//   ISSUE_FIELD_RANGE            detail = VitalID
+//   ISSUE_DUPLICATE_CFID         detail = the shared CFID
+struct RosterIssue {
+    uint16_t code;
+    uint16_t detail;
+    uint16_t team;     // Team index, ISSUE_NO_TEAM when not team-related
+    uint16_t player;   // Player index (or raw slot value, see above)
+};
+static constexpr uint16_t ISSUE_NO_TEAM = 0xFFFF;
+
+// One run of adjacent record bits that changed in at least min_records
+// records between two roster images (RosterEditor::diff_bit_runs).
+struct BitDiffRun {
+    uint32_t bit_pos;       // MSB-first from the record start
+    uint32_t width;         // Bits in the run
+    uint32_t min_records;   // Fewest / most records any bit of the run changed in
+    uint32_t max_records;
+};
+
+class RosterEditor;
+class RosterTransform;
+class FieldSearch;
+class RosterBalancer;
+class PlayerGenerator;
+
 class Player {
 public:
+    static constexpr size_t RECORD_SIZE = 1023;
+
+    // A default-constructed (or rejected) Player refers to a shared, zeroed
+    // read-only record, so accessors never need a null or bounds check;
+    // writes through it are ignored.
     Player();
-    Player(uint8_t* buffer, size_t buffer_length, size_t record_offset);
+    // The record span [record_offset, record_offset + RECORD_SIZE) is checked
+    // against buffer_length once, here; every accessor after that is
+    // unchecked. An out-of-bounds span reports ROSTER_ERR_OUT_OF_RANGE.
+    Player(uint8_t* buffer, size_t buffer_length, size_t record_offset,
+           RosterEditor* editor = nullptr, int index = -1);
 
     // -- Cyberface ID (16-bit at +28 bytes from record start) ----------------
     int  get_cfid() const;
@@ -306,8 +386,14 @@ public:
     void set_overall_rating(int rating);
 
     // -- Player name ---------------------------------------------------------
+    // Resolved through the roster's NameTable; falls back to the numeric ID
+    // when no name table was found.
     std::string get_first_name() const;
     std::string get_last_name() const;
+    int  get_first_name_id() const;
+    int  get_last_name_id() const;
+    void set_first_name(const std::string& name);
+    void set_last_name(const std::string& name);
 
     // -- Position info -------------------------------------------------------
     int get_position() const;
@@ -334,6 +420,14 @@ public:
     uint32_t get_gear_by_id(int id) const;
     void set_gear_by_id(int id, uint32_t value);
     static int get_gear_count() { return 48; }
+    // All 48 fields at once (GearID order), through one load of the gear
+    // bit-window; set_gear writes the window back with a single note_write.
+    void get_gear(uint32_t* out) const;
+    void set_gear(const uint32_t* in);
+    void copy_gear_from(const Player& other);
+    // JS variants over the Wasm heap (uint32 per field); return 48.
+    int  read_gear_block(size_t out_ptr) const;
+    int  write_gear_block(size_t in_ptr);
 
     // -- Data-driven animations (all 40) -------------------------------------
     // Starts exactly at Byte 193
@@ -356,37 +450,83 @@ public:
     void set_sig_skill(int slot, int val);
     static int get_sig_skill_count() { return 5; }
 
+    // -- Block access (one value per byte, whole block per call) -------------
+    // Each block is read or written as a single bit run. Tendencies come back
+    // as 0..127; writing them keeps every MSB category flag. Writes issue one
+    // note_write for the whole span.
+    void get_tendencies(uint8_t* out) const;        // 58 values
+    void set_tendencies(const uint8_t* in);
+    void get_hot_zones(uint8_t* out) const;         // 14 values, 0..3
+    void set_hot_zones(const uint8_t* in);
+    void get_sig_skills(uint8_t* out) const;        // 5 values, 0..63
+    void set_sig_skills(const uint8_t* in);
+    // JS variants over the Wasm heap; each returns the value count.
+    int  read_tendency_block(size_t out_ptr) const;
+    int  write_tendency_block(size_t in_ptr);
+    int  read_hot_zone_block(size_t out_ptr) const;
+    int  write_hot_zone_block(size_t in_ptr);
+    int  read_sig_skill_block(size_t out_ptr) const;
+    int  write_sig_skill_block(size_t in_ptr);
+
     // -- Record context ------------------------------------------------------
     size_t get_record_offset() const { return record_offset_; }
+    int    get_index()         const { return index_; }
+
+    // -- Ratings conversion (raw byte <-> 25..110 display scale) -------------
+    static int     raw_to_display(uint8_t raw);
+    static uint8_t display_to_raw(int display);
 
 private:
     uint8_t* buffer_;
-    size_t   buffer_length_;
     size_t   record_offset_;   // Absolute byte offset of this player's record
+    RosterEditor* editor_;     // Owning editor (null for detached records)
+    int      index_;           // Slot in the player table, -1 if detached
 
-    // Helpers — byte-aligned
+    void set_name_at(size_t offset, const std::string& name);
+
+    // Helpers — byte-aligned, unchecked (span validated at construction)
     uint8_t  read_byte_at(size_t offset) const;
     void     write_byte_at(size_t offset, uint8_t value);
     uint16_t read_u16_le(size_t offset) const;
     void     write_u16_le(size_t offset, uint16_t value);
 
-    // Helpers — bit-packed (uses BitStream internally)
+    // Helpers — bit-packed (BitStream::peek_bits / poke_bits)
     uint32_t read_bits_at(size_t byte_off, int bit_off, int count) const;
     void     write_bits_at(size_t byte_off, int bit_off, int count, uint32_t value);
 
-    // Ratings conversion
-    static int  raw_to_display(uint8_t raw);
-    static uint8_t display_to_raw(int display);
 };
 
 // ---------------------------------------------------------------------------
 // Team — represents one team record in the roster file
 // ---------------------------------------------------------------------------
 
+// Fixed-size decoded team, as written by RosterEditor::decode_teams.
+// 116 bytes, 4-byte aligned; strings are NUL-terminated.
+struct TeamInfo {
+    uint32_t color1;
+    uint32_t color2;
+    uint16_t index;          // Slot in the team table
+    uint16_t id;             // get_id()
+    uint16_t roster[15];     // get_roster_player_id(0..14), raw
+    uint16_t roster_count;   // Occupied roster slots
+    char     city[33];
+    char     name[33];
+    char     abbr[5];
+    uint8_t  reserved;
+};
+static_assert(sizeof(TeamInfo) == 116, "TeamInfo is read from JS by fixed offsets");
+
 class Team {
 public:
+    static constexpr size_t RECORD_SIZE = 716;
+    static constexpr int    ROSTER_SLOTS = 15;
+    static constexpr int    ROSTER_EMPTY = 0xFFFF;   // Unused roster slot
+
+    // Same contract as Player: span checked once at construction, and a
+    // default or rejected Team reads zeros and ignores writes.
     Team();
-    Team(uint8_t* buffer, size_t buffer_length, size_t record_offset);
+    Team(uint8_t* buffer, size_t buffer_length, size_t record_offset,
+         RosterEditor* editor = nullptr, int index = -1);
 
     // -- Basic Identifiers --
     int get_id() const;              // e.g. City ID or Team ID
@@ -409,17 +549,23 @@ public:
     int get_roster_player_id(int index) const; 
     void set_roster_player_id(int index, int player_id);
 
+    // All of the above in one go (no std::string allocations).
+    void decode(TeamInfo& out) const;
+
     // -- Record context --
     size_t get_record_offset() const { return record_offset_; }
+    int    get_index()         const { return index_; }
 
 private:
     uint8_t* buffer_;
-    size_t   buffer_length_;
     size_t   record_offset_;
+    RosterEditor* editor_;
+    int      index_;
 
-    // Helpers
+    // Helpers — unchecked
     uint8_t  read_byte_at(size_t offset) const;
     void     write_byte_at(size_t offset, uint8_t value);
+    void     read_chars_at(size_t offset, size_t count, char* out) const;   // NUL-terminates
     uint16_t read_u16_le(size_t offset) const;
     void     write_u16_le(size_t offset, uint16_t value);
     uint32_t read_u32_le(size_t offset) const;
@@ -438,21 +584,285 @@ public:
     // Does NOT take ownership — caller manages the memory.
     void init(size_t buffer_ptr, int buffer_length);
 
+    // -- Owned load buffer ---------------------------------------------------
+    // Editor-owned storage the file is read straight into, so JS needs no
+    // staging _malloc. prepare_load(length) returns where to write length
+    // bytes: the previous allocation is reused when large enough, otherwise
+    // it is freed before the larger one is taken, so repeated loads peak at
+    // about one file. A roster loaded from that storage is dropped. Then
+    // load_prepared() attaches to the bytes exactly as init() would.
+    size_t prepare_load(int length);
+    void   load_prepared();
+    int    load_prepared_async();
+    size_t get_load_capacity() const { return load_capacity_; }
+
+#if ROSTER_HAS_MMAP
+    // -- Native file mode ----------------------------------------------------
+    // Map a .ROS file and edit it in place. Discovery runs on the mapping;
+    // the name table and search index are built on first use. Whatever was
+    // loaded before is dropped first, so a failed open leaves no roster.
+    void open_file(const std::string& path, FileMode mode);
+    // Update the checksum from the pages written since the last save (the
+    // one stored in the file is the starting point) and msync the changed
+    // ranges. Fails with ROSTER_ERR_IO for FILE_READ_ONLY mappings.
+    void save_file();
+    void close_file();
+#endif
+
+    // -- Table layout --------------------------------------------------------
+    // Where discovery placed the player and team tables.
+    struct TableLayout {
+        size_t player_offset;
+        size_t player_record_size;
+        int    player_count;
+        size_t team_offset;
+        size_t team_record_size;
+        int    team_count;
+    };
+    TableLayout get_layout() const;
+    // Run table discovery alone (no name table or search index) on a buffer.
+    static TableLayout discover_layout(uint8_t* buffer, size_t length);
+
     // Player access
+    // Not const: the returned handle can write back through the editor.
     int     get_player_count() const;
-    Player  get_player(int index) const;
+    Player  get_player(int index);
+    // Copy every gear field of player `from` onto player `to`.
+    void    copy_gear(int from, int to);
+
+    // -- Record operations ---------------------------------------------------
+    // Whole-record copies. Team roster slots are fixed up through a reverse
+    // index (player → slots naming it), so a call touches only the records
+    // involved and the slots pointing at them.
+    //   clone_player  dst becomes a copy of src, as a free agent
+    //                 (VITAL_TEAM_ID1/2 = 255) with the lowest CFID no record
+    //                 uses; slots naming dst are cleared. No unused CFID left
+    //                 reports ROSTER_ERR_OUT_OF_RANGE.
+    //   swap_players  exchange the records; roster slots follow the players.
+    //   move_player   dst takes src's record and roster slots; src is zeroed
+    //                 (CFID 0, an empty slot); slots naming dst are cleared.
+    // Bad or equal indices report ROSTER_ERR_OUT_OF_RANGE / INVALID_ARGUMENT
+    // and change nothing.
+    bool    clone_player(int src, int dst);
+    bool    swap_players(int a, int b);
+    bool    move_player(int src, int dst);
+
+    // -- Slot allocation -----------------------------------------------------
+    // A slot is free when its record has a null CFID (0 / 0xFFFF) and no
+    // roster names it; slot 0 (the dummy player) never is. Free slots live in
+    // a bitmap built at discovery and kept current by set_cfid, the roster
+    // setters and the record operations, so finding one is two bit scans.
+    // Returns the lowest free slot, reserved until its CFID is set (a null
+    // CFID written later frees it again) or it is released; other record
+    // operations and snapshot restores leave the reservation alone. Returns
+    // -1 with ROSTER_ERR_OUT_OF_RANGE when the table is full.
+    int     allocate_player_slot();
+    // Zero the record (CFID 0), clear the roster slots naming it and mark it
+    // free. Slot 0 and bad indices report ROSTER_ERR_OUT_OF_RANGE.
+    bool    release_player_slot(int index);
+    int     get_free_slot_count() const;
+    // Hooks, called by Player::set_cfid and Team::set_roster_player_id.
+    void    on_cfid_changed(int index);
+    void    on_roster_slot_changed(int old_player, int new_player);
 
     // Team access
     int     get_team_count() const;
-    Team    get_team(int index) const;
+    Team    get_team(int index);
+    // Decode every team into a packed TeamInfo array at out_ptr
+    // (get_team_count() entries). Returns the number of teams written.
+    int     decode_teams(size_t out_ptr);
+
+    // -- Name dictionary -----------------------------------------------------
+    // Decoded once (at init, or on first use for mapped files).
+    // IDs are the values stored at +63 / +56.
+    int         get_name_count();
+    std::string get_name(int id);
+    // Rewrite a dictionary entry in place (all players sharing it change).
+    bool        rename_name(int id, const std::string& name);
+    // Zero-copy views: NUL-terminated UTF-8 arena + uint32 offset per ID.
+    size_t      get_name_pool_ptr();
+    int         get_name_pool_length();
+    size_t      get_name_offsets_ptr();
+    // Write [first_id, last_id] as uint16 pairs for every player to out_ptr
+    // (2 * get_player_count() entries). Returns the number of players.
+    int         export_player_name_ids(size_t out_ptr) const;
+
+    NameTable&       get_name_table()       { ensure_derived_state(); return names_; }
+
+    // -- Fuzzy search --------------------------------------------------------
+    // Ranked, typo-tolerant matches over player names and team city/name.
+    // Writes up to max_results uint32 entries to out_ptr: a player index, or
+    // a team index with SEARCH_TEAM_FLAG set. Returns the number written.
+    static constexpr uint32_t SEARCH_TEAM_FLAG = 0x80000000u;
+    int  search(const std::string& query, size_t out_ptr, int max_results);
+
+    // Keep the search index in sync after a rename (called by the setters).
+    void reindex_player(int index);
+    void reindex_players_named(int name_id);
+    void reindex_team(int index);
+
+    // -- Snapshots (what-if branches) ----------------------------------------
+    // Page-granular copy-on-write: only pages written after load are copied,
+    // and switching branches rewrites only the pages that differ.
+    void create_snapshot(const std::string& name);
+    bool restore_snapshot(const std::string& name);
+    bool delete_snapshot(const std::string& name);
+    bool has_snapshot(const std::string& name) const;
+    int  get_snapshot_count() const;
+    int  get_snapshot_memory() const;   // Bytes held by page copies
+
+    // -- Bulk transforms -----------------------------------------------------
+    // Compile (if needed) and run `t` over the player table in one pass.
+    // Slot 0 and null records (CFID 0 / 0xFFFF) are never touched. Returns
+    // the number of players whose record changed.
+    int  apply_transform(RosterTransform& t);
+
+    // -- Overall rating ------------------------------------------------------
+    // Derived from the component ratings by OverallModel. With auto-overall
+    // on, every rating or position write (setters and transforms) refreshes
+    // the affected player's RAT_OVERALL immediately. On by default; nothing
+    // is recomputed at load, so a player keeps the authored overall until
+    // one of their component ratings or their position changes.
+    int    recompute_overalls();                 // Live players (not slot 0 / null); returns # changed
+    int    compute_overall(int index);           // Model value, nothing written
+    void   set_auto_overall(bool enabled);
+    bool   get_auto_overall() const { return auto_overall_; }
+    void   set_overall_weight(int position, int rating_id, double weight);
+    double get_overall_weight(int position, int rating_id) const;
+    void   reset_overall_weights();
+    // Dependency hook, called by Player after a component rating or the
+    // position changes.
+    void   on_rating_changed(int index);
+
+    // -- Aggregate statistics ------------------------------------------------
+    // Distribution of one field (FieldKind + id, in accessor units) over the
+    // live players, grouped by StatsGroupBy. Aggregates are cached and kept
+    // current incrementally: only players written since the last query are
+    // re-sampled.
+    // Writes one FieldAggregate::Summary per non-empty group, ascending by
+    // group, to out_ptr (up to max_groups). Returns the non-empty group count.
+    int  stats_summary(int kind, int id, int group_by, size_t out_ptr, int max_groups);
+    // Writes int32 [first value, bin width, count × bins] for one group to
+    // out_ptr (up to max_bins counts). Returns the bin count; out_ptr 0 only
+    // queries it.
+    int  stats_histogram(int kind, int id, int group_by, int group, size_t out_ptr, int max_bins);
+    int  stats_quantile(int kind, int id, int group_by, int group, double q);
+    // Leaderboard of one group: writes up to k FieldLeaderboard::Entry
+    // {player, value} uint32 pairs to out_ptr, value descending (ties by
+    // index), and returns how many. Boards are cached and updated in place
+    // like the aggregates; k is capped at FieldLeaderboard::MAX_K.
+    int  stats_top(int kind, int id, int group_by, int group, int k, size_t out_ptr);
+
+    // -- Roster diff ---------------------------------------------------------
+    // Compare player records against another roster image with the same
+    // layout (e.g. the file as loaded). Writes up to max_results differing
+    // player indices to out_ptr (uint32); returns the total number found.
+    int  diff_players(size_t other_ptr, int other_length, size_t out_ptr, int max_results);
+    // Bit heatmap of the same comparison for one table (ChangeTable): writes
+    // one uint32 per record bit (record size × 8, MSB-first) counting the
+    // records in which that bit differs. Returns the number of records that
+    // differ; out_ptr 0 only counts them.
+    int  diff_bit_heatmap(size_t other_ptr, int other_length, int table, size_t out_ptr);
+    // The heatmap condensed: maximal runs of bits that changed in at least
+    // min_records records, most-changed first. Writes up to max_runs
+    // BitDiffRun entries to out_ptr; returns the total number of runs.
+    int  diff_bit_runs(size_t other_ptr, int other_length, int table, int min_records,
+                       size_t out_ptr, int max_runs);
+
+    // -- Field discovery -----------------------------------------------------
+    // Rank (bit position, width) candidates in the player record against the
+    // search's known values (see FieldSearch.hpp). Writes up to max_results
+    // FieldSearch::Candidate entries to out_ptr; returns how many qualified.
+    int  find_field(FieldSearch& search, size_t out_ptr, int max_results);
+
+    // -- Similarity search ---------------------------------------------------
+    // Live players closest to `player` under the search's metric, weights and
+    // group filter (see SimilaritySearch.hpp). Writes up to max_results
+    // SimilaritySearch::Match entries to out_ptr, closest first; returns how
+    // many players were ranked.
+    int  find_similar(SimilaritySearch& search, int player, size_t out_ptr, int max_results);
+
+    // -- Roster balancing ----------------------------------------------------
+    // Gather the balancer's teams from the team rosters and solve (see
+    // RosterBalancer.hpp); nothing is written. Returns the number of players
+    // the plan changes.
+    int  plan_balance(RosterBalancer& balancer);
+    // Write the last plan in one batch: roster slots, VITAL_TEAM_ID1/2 of
+    // each traded player, then field values. Fails with ROSTER_ERR_INVALID_ARGUMENT
+    // if the rosters or values changed since the plan. Returns players written.
+    int  apply_balance(RosterBalancer& balancer);
+
+    // -- Synthetic players ---------------------------------------------------
+    // Fill `count` free slots with generated free agents (see
+    // PlayerGenerator.hpp), lowest slots first. Each record is assembled
+    // off-table and written in one pass, with a CFID no other player uses.
+    // Writes the new player indices (int32) to out_ptr when non-zero and
+    // returns how many were made. Fails with ROSTER_ERR_OUT_OF_RANGE, writing
+    // nothing, if free slots or unused CFIDs are short of count.
+    int  generate_players(PlayerGenerator& generator, int count, size_t out_ptr);
+
+    // -- Integrity scan ------------------------------------------------------
+    // One pass over the team rosters, then one over the player table.
+    // Writes up to max_issues RosterIssue entries to out_ptr, in discovery
+    // order, and returns the total found. Cheap enough to run before every
+    // save. Empty and null player records (CFID 0 / 0xFFFF) are skipped.
+    int  validate(size_t out_ptr, int max_issues);
+
+    // -- Background tasks ----------------------------------------------------
+    // Each call returns a task handle at once; the work runs on the shared
+    // TaskScheduler (inline in single-threaded builds). Until the handle is
+    // done, JS must not call anything else on this editor except
+    // is_task_done / wait_task.
+    int  init_async(size_t buffer_ptr, int buffer_length);   // See also load_prepared_async
+    int  checksum_async();
+    // Checksum, then copy the finished file to out_ptr. Result: bytes copied.
+    int  export_async(size_t out_ptr);
+    int  diff_players_async(size_t other_ptr, int other_length, size_t out_ptr, int max_results);
+    int  plan_balance_async(RosterBalancer& balancer);
+    bool is_task_done(int handle) const;
+    // Result of the task; failures are re-reported on the calling thread.
+    int  wait_task(int handle);
+    static int get_worker_count();
+
+    // -- Change feed ---------------------------------------------------------
+    // Records written since the last drain and the field groups touched
+    // (ChangeGroup mask). Writes up to max_changes RecordChange entries to
+    // out_ptr, players before teams, and returns the number written; call
+    // again while get_pending_change_count() is non-zero. Loading a buffer
+    // starts the feed empty.
+    int  drain_changes(size_t out_ptr, int max_changes);
+    int  get_pending_change_count() const { return changes_.pending(); }
+
+    // Write barrier — every path that modifies buffer_ calls this first.
+    void note_write(size_t abs_offset, size_t length);
 
     // Recalculate the CRC32 checksum and overwrite the first 4 bytes.
     void save_and_recalculate_checksum();
 
+    // -- Streaming export ----------------------------------------------------
+    // Hand the file out in chunk_size pieces, hashing each one as it goes,
+    // so a save is a single pass with no staging copy of the whole file.
+    // begin_export() returns the chunk count. Each next_export_chunk() hashes
+    // the next piece and returns its length (0 once finished); its bytes sit
+    // at get_export_chunk_ptr() until the following call. Producing the last
+    // chunk writes the checksum into the buffer — chunk 0 went out with the
+    // old header, so the sink patches bytes [0, 4) from get_buffer_ptr().
+    // The roster must not be edited while an export is in progress.
+    int    begin_export(int chunk_size);
+    int    next_export_chunk();
+    size_t get_export_chunk_ptr() const;
+
     // Get a pointer to the buffer (for JS to read back the modified data).
     size_t    get_buffer_ptr() const;
     int       get_buffer_length() const;
 
+    // -- Status --------------------------------------------------------------
+    // RosterStatus of the last failure (sticky until clear_status). This is
+    // the only error channel in -fno-exceptions builds.
+    int         get_last_status() const { return static_cast<int>(roster_last_status()); }
+    std::string get_last_error()  const { return roster_last_error(); }
+    void        clear_status()          { roster_clear_status(); }
+
 private:
     uint8_t* buffer_;
     size_t   buffer_length_;
@@ -466,7 +876,76 @@ private:
     int      team_count_;
     size_t   team_record_size_;
 
+    NameTable     names_;
+    SearchIndex   search_;
+    SnapshotStore snapshots_;
+    bool          derived_ready_;   // names_ / search_ built for this buffer
+    OverallModel  overall_;
+    bool          auto_overall_;
+    RosterStats   stats_;
+    PlayerVectors vectors_;         // Columnar ratings/tendencies for find_similar
+    ChangeFeed    changes_;
+    // Reverse roster index: per player, (team << 4 | slot) of every roster
+    // slot naming it. Rebuilt lazily after any write to the team table.
+    std::vector<std::vector<uint16_t>> roster_refs_;
+    bool          roster_refs_ready_;
+    // Free-slot bitmap (bit set = free) with a summary word whose bit w is
+    // set while free_slots_[w] has any free bit. reserved_slots_ marks null
+    // slots handed out by allocate_player_slot; roster_uses_ counts the
+    // roster slots naming each player.
+    std::vector<uint64_t> free_slots_;
+    uint64_t              free_words_;
+    std::vector<uint64_t> reserved_slots_;
+    std::vector<uint16_t> roster_uses_;
+    // Streaming export cursor: [export_pos_, +export_len_) is the current
+    // chunk; export_crc_ covers the payload bytes handed out so far.
+    size_t        export_chunk_size_;
+    size_t        export_pos_;
+    size_t        export_len_;
+    unsigned long export_crc_;
+    // Owned load buffer (prepare_load); capacity is rounded to LOAD_GRANULE.
+    std::unique_ptr<uint8_t[]> load_buffer_;
+    size_t        load_capacity_;
+    size_t        load_length_;
+#if ROSTER_HAS_MMAP
+    MappedFile    file_;
+#endif
+
     // Internal discovery
     void discover_player_table();
     void discover_team_table();
+    void load_name_table();
+    void count_name_refs();
+    void build_search_index();
+    // Point the editor at a new buffer and run table discovery.
+    void attach(uint8_t* buffer, size_t length);
+    // Forget the buffer and everything discovered in it.
+    void detach();
+    // Rebuild caches derived from buffer_ after it changed wholesale.
+    void refresh_derived_state();
+    void ensure_derived_state() { if (!derived_ready_) refresh_derived_state(); }
+    void write_checksum(uint32_t crc);
+    bool recompute_overall(int index);
+    // Record operation helpers
+    bool check_record_pair(const char* what, int a, int b) const;
+    void ensure_roster_index();
+    void point_roster_refs(int player, int value);   // Rewrite its slots to `value`
+    void change_name_refs(int index, bool add);
+    void vacate_record(int index);                     // Zero it; slots must be cleared
+    // Lowest `count` CFIDs >= first that no record uses; false if short.
+    bool unused_cfids(int first, int count, std::vector<uint16_t>& out) const;
+    // Slot allocation helpers
+    void rebuild_free_slots();
+    void refresh_slot(int index);
+    void set_slot_free(int index, bool free);
+    // Per-bit change counts over one table vs. `other`; returns records that
+    // differ, or -1 after reporting a bad argument.
+    int  bit_heatmap(const char* what, size_t other_ptr, int other_length, int table,
+                     std::vector<uint32_t>& counts) const;
+    // Cached aggregate for the key, re-sampled where dirty; null if invalid.
+    FieldAggregate* aggregate(int kind, int id, int group_by);
+    // Cached leaderboard keeping at least k per group, likewise.
+    FieldLeaderboard* leaderboard(int kind, int id, int group_by, int k);
+    // Player's value and group for a stats field; false for null records.
+    bool sample_stat(int kind, const FieldLoc& loc, int group_by, int index, int& group, int64_t& value) const;
 };
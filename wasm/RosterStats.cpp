@@ -0,0 +1,317 @@
+// ============================================================================
+// RosterStats.cpp — Grouped field histograms, leaderboards and their cache
+// ============================================================================
+
+#include "RosterStats.hpp"
+#include <algorithm>
+#include <cmath>
+
+// ============================================================================
+// DirtyPlayers
+// ============================================================================
+
+DirtyPlayers::DirtyPlayers(size_t player_count)
+    : n_(player_count), bits_((player_count + 63) / 64, 0), count_(0)
+{}
+
+void DirtyPlayers::mark(int player) {
+    if (player < 0 || static_cast<size_t>(player) >= n_) return;
+    uint64_t bit = uint64_t(1) << (player & 63);
+    uint64_t& word = bits_[player >> 6];
+    if (!(word & bit)) {
+        word |= bit;
+        ++count_;
+    }
+}
+
+void DirtyPlayers::mark_all() {
+    std::fill(bits_.begin(), bits_.end(), ~uint64_t(0));
+    if (n_ % 64) bits_.back() = (uint64_t(1) << (n_ % 64)) - 1;
+    count_ = static_cast<int>(n_);
+}
+
+// ============================================================================
+// FieldAggregate
+// ============================================================================
+
+FieldAggregate::FieldAggregate(int group_count, int64_t lo, int64_t hi, int player_count)
+    : lo_(lo), hi_(std::max(lo, hi)), shift_(0), bins_(0),
+      groups_(static_cast<size_t>(std::max(group_count, 1))),
+      sample_group_(static_cast<size_t>(std::max(player_count, 0)), NO_GROUP),
+      sample_value_(sample_group_.size(), 0),
+      dirty_(sample_group_.size())
+{
+    uint64_t span = static_cast<uint64_t>(hi_ - lo_);
+    while ((span >> shift_) >= static_cast<uint64_t>(MAX_BINS)) ++shift_;
+    bins_ = static_cast<int>(span >> shift_) + 1;
+}
+
+int FieldAggregate::bin_of(int64_t value) const {
+    value = std::min(std::max(value, lo_), hi_);
+    return static_cast<int>(static_cast<uint64_t>(value - lo_) >> shift_);
+}
+
+void FieldAggregate::update(int player, int group, int64_t value) {
+    if (player < 0 || static_cast<size_t>(player) >= sample_group_.size()) return;
+    if (group >= group_count()) group = NO_GROUP;
+
+    int old_group = sample_group_[player];
+    if (old_group != NO_GROUP) {
+        Group& g = groups_[old_group];
+        double v = static_cast<double>(sample_value_[player]);
+        --g.count;
+        g.sum    -= v;
+        g.sum_sq -= v * v;
+        --g.bins[bin_of(sample_value_[player])];
+    }
+
+    sample_group_[player] = group;
+    sample_value_[player] = value;
+    if (group == NO_GROUP) return;
+
+    Group& g = groups_[group];
+    if (g.bins.empty()) g.bins.assign(static_cast<size_t>(bins_), 0);
+    double v = static_cast<double>(value);
+    ++g.count;
+    g.sum    += v;
+    g.sum_sq += v * v;
+    ++g.bins[bin_of(value)];
+}
+
+// ============================================================================
+// Queries
+// ============================================================================
+
+int FieldAggregate::count(int group) const {
+    if (group < 0 || group >= group_count()) return 0;
+    return groups_[group].count;
+}
+
+const uint32_t* FieldAggregate::histogram(int group) const {
+    if (count(group) == 0) return nullptr;
+    return groups_[group].bins.data();
+}
+
+int64_t FieldAggregate::quantile(int group, double q) const {
+    int n = count(group);
+    if (n == 0) return 0;
+    const std::vector<uint32_t>& bins = groups_[group].bins;
+    // Nearest-rank: the smallest bin whose cumulative count reaches q·n.
+    q = std::min(std::max(q, 0.0), 1.0);
+    uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(q * n)));
+    uint64_t seen = 0;
+    for (int b = 0; b < bins_; ++b) {
+        seen += bins[b];
+        if (seen >= rank) return bin_value(b);
+    }
+    return bin_value(bins_ - 1);
+}
+
+bool FieldAggregate::summarize(int group, Summary& out) const {
+    int n = count(group);
+    if (n == 0) return false;
+    const Group& g = groups_[group];
+
+    int first = 0, last = bins_ - 1;
+    while (g.bins[first] == 0) ++first;
+    while (g.bins[last] == 0) --last;
+
+    double mean = g.sum / n;
+    double var  = std::max(0.0, g.sum_sq / n - mean * mean);
+
+    out.group  = group;
+    out.count  = n;
+    out.mean   = static_cast<float>(mean);
+    out.stddev = static_cast<float>(std::sqrt(var));
+    out.min    = static_cast<int32_t>(bin_value(first));
+    out.max    = static_cast<int32_t>(bin_value(last));
+    out.p10    = static_cast<int32_t>(quantile(group, 0.10));
+    out.p25    = static_cast<int32_t>(quantile(group, 0.25));
+    out.p50    = static_cast<int32_t>(quantile(group, 0.50));
+    out.p75    = static_cast<int32_t>(quantile(group, 0.75));
+    out.p90    = static_cast<int32_t>(quantile(group, 0.90));
+    return true;
+}
+
+size_t FieldAggregate::memory_bytes() const {
+    size_t bytes = sample_group_.size() * (sizeof(int32_t) + sizeof(int64_t)) + dirty_.memory_bytes();
+    for (const Group& g : groups_) bytes += sizeof(Group) + g.bins.size() * sizeof(uint32_t);
+    return bytes;
+}
+
+// ============================================================================
+// FieldLeaderboard
+// ============================================================================
+
+FieldLeaderboard::FieldLeaderboard(int group_count, int k, int player_count)
+    : k_(std::min(std::max(k, 1), MAX_K)),
+      groups_(static_cast<size_t>(std::max(group_count, 1))),
+      sample_group_(static_cast<size_t>(std::max(player_count, 0)), NO_GROUP),
+      sample_value_(sample_group_.size(), 0),
+      dirty_(sample_group_.size())
+{}
+
+void FieldLeaderboard::update(int player, int group, int64_t value) {
+    if (player < 0 || static_cast<size_t>(player) >= sample_group_.size()) return;
+    if (group >= group_count()) group = NO_GROUP;
+
+    int old_group = sample_group_[player];
+    if (old_group != NO_GROUP) remove(groups_[old_group], { sample_value_[player], player });
+    sample_group_[player] = group;
+    sample_value_[player] = value;
+    if (group != NO_GROUP) insert(groups_[group], { value, player });
+}
+
+void FieldLeaderboard::insert(Group& g, const Key& key) {
+    bool outsiders = g.count > static_cast<int>(g.top.size());
+    ++g.count;
+    // Anything ranking at or after floor joins the outsiders; floor still
+    // bounds them all.
+    if (outsiders && !ranks_before(key, g.floor)) return;
+
+    g.top.insert(std::lower_bound(g.top.begin(), g.top.end(), key, ranks_before), key);
+    if (static_cast<int>(g.top.size()) > k_) {
+        g.floor = g.top.back();
+        g.top.pop_back();
+    }
+}
+
+// A member leaving a full board opens a slot only an outsider can fill; the
+// board is left short and top() rescans the group if the slot is needed.
+void FieldLeaderboard::remove(Group& g, const Key& key) {
+    --g.count;
+    auto it = std::lower_bound(g.top.begin(), g.top.end(), key, ranks_before);
+    if (it != g.top.end() && it->player == key.player) g.top.erase(it);
+}
+
+void FieldLeaderboard::assign(int player, int group, int64_t value) {
+    if (player < 0 || static_cast<size_t>(player) >= sample_group_.size()) return;
+    sample_group_[player] = group < group_count() ? group : NO_GROUP;
+    sample_value_[player] = value;
+}
+
+void FieldLeaderboard::select_top(Group& g, std::vector<Key>& members) {
+    g.count = static_cast<int>(members.size());
+    size_t keep = std::min(members.size(), static_cast<size_t>(k_));
+    if (members.size() > keep) {
+        // Best keep + 1 to the front; the (keep + 1)-th becomes the floor.
+        std::nth_element(members.begin(), members.begin() + keep, members.end(), ranks_before);
+        g.floor = members[keep];
+    }
+    std::sort(members.begin(), members.begin() + keep, ranks_before);
+    g.top.assign(members.begin(), members.begin() + keep);
+}
+
+void FieldLeaderboard::rebuild() {
+    std::vector<std::vector<Key>> members(groups_.size());
+    for (size_t p = 0; p < sample_group_.size(); ++p) {
+        int group = sample_group_[p];
+        if (group != NO_GROUP) members[group].push_back({ sample_value_[p], static_cast<int32_t>(p) });
+    }
+    for (size_t group = 0; group < groups_.size(); ++group) select_top(groups_[group], members[group]);
+}
+
+void FieldLeaderboard::rebuild_group(int group) {
+    std::vector<Key> members;
+    members.reserve(static_cast<size_t>(groups_[group].count));
+    for (size_t p = 0; p < sample_group_.size(); ++p) {
+        if (sample_group_[p] == group) members.push_back({ sample_value_[p], static_cast<int32_t>(p) });
+    }
+    select_top(groups_[group], members);
+}
+
+int FieldLeaderboard::top(int group, int k, Entry* out) {
+    if (group < 0 || group >= group_count()) return 0;
+    Group& g = groups_[group];
+    int n = std::min(std::min(k, k_), g.count);
+    if (n <= 0) return 0;
+    if (static_cast<int>(g.top.size()) < n) rebuild_group(group);
+
+    for (int i = 0; i < n; ++i) {
+        out[i].player = g.top[i].player;
+        out[i].value  = static_cast<uint32_t>(g.top[i].value);
+    }
+    return n;
+}
+
+size_t FieldLeaderboard::memory_bytes() const {
+    size_t bytes = sample_group_.size() * (sizeof(int32_t) + sizeof(int64_t)) + dirty_.memory_bytes();
+    for (const Group& g : groups_) bytes += sizeof(Group) + g.top.capacity() * sizeof(Key);
+    return bytes;
+}
+
+// ============================================================================
+// RosterStats — LRU cache of aggregates
+// ============================================================================
+
+RosterStats::RosterStats() : clock_(0) {}
+
+void RosterStats::clear() {
+    entries_.clear();
+    boards_.clear();
+}
+
+uint64_t RosterStats::make_key(int kind, int id, int group_by) {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(kind)) << 40) |
+           (static_cast<uint64_t>(static_cast<uint32_t>(id)) << 8) |
+           static_cast<uint64_t>(group_by & 0xFF);
+}
+
+FieldAggregate* RosterStats::find(int kind, int id, int group_by) {
+    uint64_t key = make_key(kind, id, group_by);
+    for (Entry& e : entries_) {
+        if (e.key != key) continue;
+        e.last_used = ++clock_;
+        return e.agg.get();
+    }
+    return nullptr;
+}
+
+FieldAggregate* RosterStats::insert(int kind, int id, int group_by, std::unique_ptr<FieldAggregate> agg) {
+    if (entries_.size() >= static_cast<size_t>(MAX_CACHED)) {
+        auto lru = std::min_element(entries_.begin(), entries_.end(),
+            [](const Entry& a, const Entry& b) { return a.last_used < b.last_used; });
+        entries_.erase(lru);
+    }
+    entries_.push_back({ make_key(kind, id, group_by), ++clock_, std::move(agg) });
+    return entries_.back().agg.get();
+}
+
+FieldLeaderboard* RosterStats::find_board(int kind, int id, int group_by) {
+    uint64_t key = make_key(kind, id, group_by);
+    for (BoardEntry& e : boards_) {
+        if (e.key != key) continue;
+        e.last_used = ++clock_;
+        return e.board.get();
+    }
+    return nullptr;
+}
+
+FieldLeaderboard* RosterStats::insert_board(int kind, int id, int group_by, std::unique_ptr<FieldLeaderboard> board) {
+    uint64_t key = make_key(kind, id, group_by);
+    boards_.erase(std::remove_if(boards_.begin(), boards_.end(),
+                                 [key](const BoardEntry& e) { return e.key == key; }),
+                  boards_.end());
+    if (boards_.size() >= static_cast<size_t>(MAX_CACHED)) {
+        auto lru = std::min_element(boards_.begin(), boards_.end(),
+            [](const BoardEntry& a, const BoardEntry& b) { return a.last_used < b.last_used; });
+        boards_.erase(lru);
+    }
+    boards_.push_back({ key, ++clock_, std::move(board) });
+    return boards_.back().board.get();
+}
+
+void RosterStats::mark_player(int player) {
+    for (Entry& e : entries_) e.agg->mark_dirty(player);
+    for (BoardEntry& e : boards_) e.board->mark_dirty(player);
+}
+
+int RosterStats::group_count(int group_by) {
+    switch (group_by) {
+        case STATS_ALL:              return 1;
+        case STATS_BY_TEAM:          return 256;
+        case STATS_BY_POSITION:      return 6;
+        case STATS_BY_TEAM_POSITION: return 256 * 6;
+        default:                     return 0;
+    }
+}
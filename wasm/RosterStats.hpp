@@ -0,0 +1,249 @@
+#pragma once
+// ============================================================================
+// RosterStats.hpp — Grouped distributions of one player field
+// ============================================================================
+//
+// A FieldAggregate holds, for one (field, grouping) pair, the sampled value
+// and group of every player plus a histogram per group. Mean, spread, min,
+// max and quantiles are all read off the histogram, so a query costs
+// O(groups × bins) no matter how many players there are.
+//
+// Updates are incremental: the write barrier marks players dirty, and the
+// next query re-samples only those players, moving each one out of its old
+// bucket/group and into the new one. The first query samples everyone in
+// one sequential pass.
+//
+// Values are binned exactly when the field's domain has at most MAX_BINS
+// values (ratings, tendencies, animations, hot zones, sig skills, most gear).
+// Wider fields use power-of-two buckets, making min/max/quantiles approximate
+// to the bucket width; mean and stddev stay exact.
+//
+// A FieldLeaderboard keeps, per group, the K best players for one field
+// (value descending, ties by player index). It is built by partial selection
+// in one pass; afterwards each re-sampled player costs a binary search plus a
+// shift within its group's K entries. Only when a member falls out of a full
+// board with other players waiting outside is that group rescanned, lazily on
+// the next read.
+//
+// RosterStats is the per-editor cache of aggregates and leaderboards, keyed
+// by (kind, id, grouping) and bounded with LRU eviction.
+// ============================================================================
+
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+enum StatsGroupBy {
+    STATS_ALL = 0,            // One group (0)
+    STATS_BY_TEAM,            // VITAL_TEAM_ID1 byte, 0..255 (255 = free agent)
+    STATS_BY_POSITION,        // VITAL_POSITION 0..4, 5 = unknown position byte
+    STATS_BY_TEAM_POSITION,   // team * 6 + position group
+    STATS_GROUP_BY_COUNT
+};
+
+// Players to re-sample before the next read, one bit each.
+class DirtyPlayers {
+public:
+    explicit DirtyPlayers(size_t player_count);
+
+    void mark(int player);
+    void mark_all();
+    bool any() const { return count_ > 0; }
+    // fn(player) for every marked player in index order, then clear the set.
+    template <typename Fn>
+    void drain(Fn fn);
+
+    size_t memory_bytes() const { return bits_.size() * 8; }
+
+private:
+    size_t                n_;
+    std::vector<uint64_t> bits_;
+    int                   count_;
+};
+
+template <typename Fn>
+void DirtyPlayers::drain(Fn fn) {
+    if (count_ == 0) return;
+    for (size_t w = 0; w < bits_.size(); ++w) {
+        uint64_t bits = bits_[w];
+        while (bits) {
+            int b = __builtin_ctzll(bits);
+            bits &= bits - 1;
+            fn(static_cast<int>(w * 64 + b));
+        }
+        bits_[w] = 0;
+    }
+    count_ = 0;
+}
+
+class FieldAggregate {
+public:
+    static constexpr int MAX_BINS = 256;
+    static constexpr int NO_GROUP = -1;
+
+    // Packed result record, 44 bytes (11 × 32-bit) for JS typed-array reads.
+    struct Summary {
+        int32_t group;
+        int32_t count;
+        float   mean;
+        float   stddev;
+        int32_t min, max;
+        int32_t p10, p25, p50, p75, p90;
+    };
+
+    FieldAggregate(int group_count, int64_t lo, int64_t hi, int player_count);
+
+    // Replace player's sample. NO_GROUP leaves it out of every group.
+    void update(int player, int group, int64_t value);
+
+    // -- Dirty tracking (players to re-sample before the next read) ----------
+    void mark_dirty(int player) { dirty_.mark(player); }
+    void mark_all_dirty()       { dirty_.mark_all(); }
+    bool has_dirty() const      { return dirty_.any(); }
+    // fn(player) for every dirty player in index order, then clear the set.
+    template <typename Fn>
+    void drain_dirty(Fn fn)     { dirty_.drain(fn); }
+
+    // -- Queries -------------------------------------------------------------
+    int     group_count() const { return static_cast<int>(groups_.size()); }
+    int     count(int group) const;
+    bool    summarize(int group, Summary& out) const;   // False if empty
+    int64_t quantile(int group, double q) const;        // q in [0, 1]
+    int     bin_count() const { return bins_; }
+    int64_t bin_lo() const    { return lo_; }
+    int64_t bin_width() const { return int64_t(1) << shift_; }
+    // Counts per bin (bin_count() entries), or null for an empty group.
+    const uint32_t* histogram(int group) const;
+
+    size_t memory_bytes() const;
+
+private:
+    struct Group {
+        int      count  = 0;
+        double   sum    = 0;
+        double   sum_sq = 0;
+        std::vector<uint32_t> bins;   // Allocated on first member
+    };
+
+    int64_t lo_, hi_;
+    int     shift_;                   // Bucket = (value - lo) >> shift
+    int     bins_;
+
+    std::vector<Group>    groups_;
+    std::vector<int32_t>  sample_group_;    // Per player, NO_GROUP if excluded
+    std::vector<int64_t>  sample_value_;
+    DirtyPlayers          dirty_;
+
+    int bin_of(int64_t value) const;
+    int64_t bin_value(int bin) const { return lo_ + (static_cast<int64_t>(bin) << shift_); }
+};
+
+class FieldLeaderboard {
+public:
+    static constexpr int MAX_K    = 100;
+    static constexpr int NO_GROUP = -1;
+
+    // Packed result record, 8 bytes, for JS Uint32Array reads. Values are
+    // raw field bits (gear and contract fields use all 32) or display ratings.
+    struct Entry {
+        int32_t  player;
+        uint32_t value;
+    };
+
+    // Keeps the best min(k, MAX_K) players of every group.
+    FieldLeaderboard(int group_count, int k, int player_count);
+
+    // Replace player's sample and re-rank it within its old and new group.
+    void update(int player, int group, int64_t value);
+    // Bulk load: set samples without ranking, then rebuild() every group.
+    void assign(int player, int group, int64_t value);
+    void rebuild();
+
+    // -- Dirty tracking (players to re-sample before the next read) ----------
+    void mark_dirty(int player) { dirty_.mark(player); }
+    void mark_all_dirty()       { dirty_.mark_all(); }
+    bool has_dirty() const      { return dirty_.any(); }
+    template <typename Fn>
+    void drain_dirty(Fn fn)     { dirty_.drain(fn); }
+
+    // -- Queries -------------------------------------------------------------
+    int capacity() const    { return k_; }
+    int group_count() const { return static_cast<int>(groups_.size()); }
+    // Writes the group's best min(k, capacity(), members) entries to out,
+    // best first, and returns how many.
+    int top(int group, int k, Entry* out);
+
+    size_t memory_bytes() const;
+
+private:
+    struct Key {
+        int64_t value;
+        int32_t player;
+    };
+    // Board invariant: top holds the group's best entries in rank order;
+    // while players remain outside, all of them rank at or after floor and
+    // every member ranks before it.
+    struct Group {
+        int              count = 0;
+        std::vector<Key> top;
+        Key              floor = { 0, 0 };
+    };
+
+    int k_;
+    std::vector<Group>   groups_;
+    std::vector<int32_t> sample_group_;
+    std::vector<int64_t> sample_value_;
+    DirtyPlayers         dirty_;
+
+    static bool ranks_before(const Key& a, const Key& b) {
+        return a.value != b.value ? a.value > b.value : a.player < b.player;
+    }
+    void insert(Group& g, const Key& key);
+    void remove(Group& g, const Key& key);
+    void rebuild_group(int group);
+    // Rank members (any order) into g: best k_ kept, floor set past them.
+    void select_top(Group& g, std::vector<Key>& members);
+};
+
+class RosterStats {
+public:
+    static constexpr int MAX_CACHED = 16;
+
+    RosterStats();
+
+    // Drop every aggregate (new buffer / table layout).
+    void clear();
+    bool empty() const { return entries_.empty() && boards_.empty(); }
+
+    // Cached aggregate for the key, or null.
+    FieldAggregate* find(int kind, int id, int group_by);
+    // Insert a fresh aggregate (evicting the least recently used one).
+    FieldAggregate* insert(int kind, int id, int group_by, std::unique_ptr<FieldAggregate> agg);
+
+    // Same for leaderboards; inserting replaces any board under the key.
+    FieldLeaderboard* find_board(int kind, int id, int group_by);
+    FieldLeaderboard* insert_board(int kind, int id, int group_by, std::unique_ptr<FieldLeaderboard> board);
+
+    // Write-barrier hook: player's record changed.
+    void mark_player(int player);
+
+    static int group_count(int group_by);
+
+private:
+    struct Entry {
+        uint64_t key;
+        uint64_t last_used;
+        std::unique_ptr<FieldAggregate> agg;
+    };
+    struct BoardEntry {
+        uint64_t key;
+        uint64_t last_used;
+        std::unique_ptr<FieldLeaderboard> board;
+    };
+    std::vector<Entry>      entries_;
+    std::vector<BoardEntry> boards_;
+    uint64_t                clock_;
+
+    static uint64_t make_key(int kind, int id, int group_by);
+};
@@ -0,0 +1,35 @@
+// ============================================================================
+// RosterStatus.cpp — Status recording / exception mapping
+// ============================================================================
+
+#include "RosterStatus.hpp"
+#include <stdexcept>
+
+// One slot per thread, like errno.
+static thread_local RosterStatus g_last_status = ROSTER_OK;
+static thread_local std::string  g_last_error;
+
+void roster_fail(RosterStatus status, const std::string& what) {
+    g_last_status = status;
+    g_last_error  = what;
+#if defined(__cpp_exceptions)
+    switch (status) {
+        case ROSTER_ERR_OUT_OF_RANGE:      throw std::out_of_range(what);
+        case ROSTER_ERR_INVALID_ARGUMENT:  throw std::invalid_argument(what);
+        default:                           throw std::runtime_error(what);
+    }
+#endif
+}
+
+RosterStatus roster_last_status() {
+    return g_last_status;
+}
+
+const std::string& roster_last_error() {
+    return g_last_error;
+}
+
+void roster_clear_status() {
+    g_last_status = ROSTER_OK;
+    g_last_error.clear();
+}
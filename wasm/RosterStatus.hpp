@@ -0,0 +1,37 @@
+#pragma once
+// ============================================================================
+// RosterStatus.hpp — Error reporting that works with or without exceptions
+// ============================================================================
+//
+// Every failure in the engine goes through roster_fail(). The status is
+// always recorded (sticky until roster_clear_status()), and then:
+//   - with C++ exceptions enabled, the matching std exception is thrown, so
+//     callers see the same behavior as before;
+//   - under -fno-exceptions, roster_fail() returns and the caller falls back
+//     to a neutral value (0, a null record handle, an unchanged buffer).
+//
+// Exceptions remain the primary channel in the default build: roster_fail()
+// never returns there, so the fallback that follows each call (a `return 0`,
+// `*this = Player()`, ...) only runs in the NOEXCEPT=1 flavor. Code after
+// roster_fail() must still leave the object valid, since that flavor relies
+// on it, but default-build callers must catch rather than test a result.
+//
+// JS reads the status through RosterEditor::get_last_status().
+// ============================================================================
+
+#include <string>
+
+enum RosterStatus {
+    ROSTER_OK = 0,
+    ROSTER_ERR_INVALID_ARGUMENT,   // Bad buffer, bit count, etc.
+    ROSTER_ERR_OUT_OF_RANGE,       // Index / offset / value outside its range
+    ROSTER_ERR_NO_BUFFER,          // Operation needs a loaded roster
+    ROSTER_ERR_NAME_TABLE,         // Name table missing or full
+    ROSTER_ERR_IO,                 // File open / map / sync failed (native)
+    ROSTER_ERR_INTERNAL            // Unexpected failure in a background task
+};
+
+void               roster_fail(RosterStatus status, const std::string& what);
+RosterStatus       roster_last_status();
+const std::string& roster_last_error();
+void               roster_clear_status();
@@ -0,0 +1,132 @@
+// ============================================================================
+// RosterTransform.cpp — Transform builder / compiler
+// ============================================================================
+
+#include "RosterTransform.hpp"
+
+RosterTransform::RosterTransform()
+    : position_mask_(-1), team_id_(-1), compiled_(false)
+{}
+
+void RosterTransform::clear() {
+    position_mask_ = -1;
+    team_id_ = -1;
+    range_specs_.clear();
+    ops_.clear();
+    compiled_ = false;
+}
+
+// -- Filter -------------------------------------------------------------------
+
+void RosterTransform::where_positions(int mask) {
+    position_mask_ = mask;
+    compiled_ = false;
+}
+
+void RosterTransform::where_team(int team_id) {
+    team_id_ = team_id;
+    compiled_ = false;
+}
+
+void RosterTransform::where_range(int kind, int id, int lo, int hi) {
+    range_specs_.push_back({ kind, id, static_cast<float>(lo), static_cast<float>(hi) });
+    compiled_ = false;
+}
+
+// -- Steps --------------------------------------------------------------------
+
+void RosterTransform::push(OpCode op, int kind, int id, float a, float b, int src_kind, int src_id) {
+    ops_.push_back({ op, kind, id, src_kind, src_id, a, b });
+    compiled_ = false;
+}
+
+void RosterTransform::scale(int kind, int id, double factor) {
+    push(OP_SCALE, kind, id, static_cast<float>(factor), 0.0f);
+}
+
+void RosterTransform::add(int kind, int id, int delta) {
+    push(OP_ADD, kind, id, static_cast<float>(delta), 0.0f);
+}
+
+void RosterTransform::clamp(int kind, int id, int lo, int hi) {
+    push(OP_CLAMP, kind, id, static_cast<float>(lo), static_cast<float>(hi));
+}
+
+void RosterTransform::set(int kind, int id, int value) {
+    push(OP_SET, kind, id, static_cast<float>(value), 0.0f);
+}
+
+void RosterTransform::copy_from(int kind, int id, int src_kind, int src_id) {
+    push(OP_COPY, kind, id, 0.0f, 0.0f, src_kind, src_id);
+}
+
+// -- Compilation --------------------------------------------------------------
+
+// Floats hold every integer up to 2^24 exactly.
+static constexpr int MAX_FLOAT_FIELD_WIDTH = 24;
+
+static bool float_editable(int kind, int id) {
+    FieldLoc loc;
+    return locate_player_field(kind, id, loc) && loc.width <= MAX_FLOAT_FIELD_WIDTH;
+}
+
+int RosterTransform::column_for(int kind, int id) {
+    for (size_t i = 0; i < columns_.size(); ++i) {
+        if (columns_[i].kind == kind && columns_[i].id == id) return static_cast<int>(i);
+    }
+    Column c;
+    if (!locate_player_field(kind, id, c.loc) || c.loc.width > MAX_FLOAT_FIELD_WIDTH) {
+        roster_fail(ROSTER_ERR_INVALID_ARGUMENT, "RosterTransform: field cannot be transformed");
+        return -1;
+    }
+    int lo, hi;
+    player_field_domain(kind, id, lo, hi);
+    c.kind = kind;
+    c.id = id;
+    c.lo = static_cast<float>(lo);
+    c.hi = static_cast<float>(hi);
+    c.written = false;
+    columns_.push_back(c);
+    return static_cast<int>(columns_.size() - 1);
+}
+
+bool RosterTransform::compile() {
+    if (compiled_) return true;
+    columns_.clear();
+    steps_.clear();
+    ranges_.clear();
+
+    for (const RangeSpec& r : range_specs_) {
+        int col = column_for(r.kind, r.id);
+        if (col < 0) return false;
+        ranges_.push_back({ col, r.lo, r.hi });
+    }
+
+    for (const Op& op : ops_) {
+        int first = op.id, last = op.id;
+        if (op.id == -1) {
+            first = 0;
+            last = player_field_count(op.kind) - 1;
+        }
+        for (int id = first; id <= last; ++id) {
+            // "Every field" means every field a float can edit (not the
+            // 32-bit shoe gear); a named over-wide field still fails below.
+            if (op.id == -1 && (!float_editable(op.kind, id) ||
+                                (op.op == OP_COPY && op.src_id == -1 && !float_editable(op.src_kind, id)))) {
+                continue;
+            }
+            int dst = column_for(op.kind, id);
+            if (dst < 0) return false;
+            int src = -1;
+            if (op.op == OP_COPY) {
+                src = column_for(op.src_kind, op.src_id == -1 ? id : op.src_id);
+                if (src < 0) return false;
+            }
+            columns_[dst].written = true;
+            steps_.push_back({ op.op, dst, src, op.a, op.b });
+        }
+    }
+
+    compiled_ = true;
+    return true;
+}
@@ -0,0 +1,104 @@
+#pragma once
+// ============================================================================
+// RosterTransform.hpp — Compiled roster-wide edit expressions
+// ============================================================================
+//
+// A transform is a player filter plus an ordered list of per-field steps:
+//
+//     RosterTransform t;
+//     t.where_positions(0b00011);                 // PG | SG
+//     t.scale(FIELD_RATING, RAT_SHOT_3PT, 1.05);
+//     t.clamp(FIELD_TENDENCY, -1, 0, 90);         // -1 = every tendency
+//     editor.apply_transform(t);
+//
+// compile() resolves the fields to record bit locations and expands "-1"
+// into one step per field. It runs once and is redone only after the
+// transform changes. RosterEditor::apply_transform then makes a single pass
+// over the player table, gathering matching players into one float column
+// per field. Each step runs as a branch-free loop over a column, and only
+// the values that changed are written back.
+// ============================================================================
+
+#include "RosterEditor.hpp"
+#include <cstdint>
+#include <vector>
+
+class RosterTransform {
+public:
+    enum OpCode { OP_SCALE = 0, OP_ADD, OP_CLAMP, OP_SET, OP_COPY };
+
+    struct Column {
+        int      kind;
+        int      id;
+        FieldLoc loc;
+        float    lo, hi;        // Value domain of the field
+        bool     written;       // Target of at least one step
+    };
+
+    struct Step {
+        OpCode op;
+        int    dst;             // Column index
+        int    src;             // Column index (OP_COPY only)
+        float  a, b;            // Operands (b: CLAMP upper bound)
+    };
+
+    struct Range {
+        int   column;
+        float lo, hi;
+    };
+
+    RosterTransform();
+
+    // -- Filter (all conditions must hold) ----------------------------------
+    void where_positions(int mask);     // Bit p set = VITAL_POSITION p passes
+    void where_team(int team_id);       // VITAL_TEAM_ID1 equals team_id
+    void where_range(int kind, int id, int lo, int hi);
+
+    // -- Steps, applied in order. id -1 = every field of that kind ----------
+    void scale(int kind, int id, double factor);
+    void add(int kind, int id, int delta);
+    void clamp(int kind, int id, int lo, int hi);
+    void set(int kind, int id, int value);
+    void copy_from(int kind, int id, int src_kind, int src_id);
+
+    void clear();
+    int  get_step_count() const { return static_cast<int>(ops_.size()); }
+
+    // Resolve the plan. Reports ROSTER_ERR_INVALID_ARGUMENT and returns false
+    // for unknown fields, or for fields too wide to edit as floats (> 24 bits).
+    // An id of -1 expands to the fields of that kind that fit, skipping the
+    // over-wide ones.
+    bool compile();
+
+    int  position_mask() const { return position_mask_; }
+    int  team_id()       const { return team_id_; }
+    const std::vector<Column>& columns() const { return columns_; }
+    const std::vector<Step>&   steps()   const { return steps_; }
+    const std::vector<Range>&  ranges()  const { return ranges_; }
+
+private:
+    // As written by the caller, before expansion / resolution.
+    struct Op {
+        OpCode op;
+        int    kind, id;
+        int    src_kind, src_id;
+        float  a, b;
+    };
+    struct RangeSpec {
+        int   kind, id;
+        float lo, hi;
+    };
+
+    int position_mask_;               // -1 = any position
+    int team_id_;                     // -1 = any team
+    std::vector<RangeSpec> range_specs_;
+    std::vector<Op>        ops_;
+
+    bool compiled_;
+    std::vector<Column> columns_;
+    std::vector<Step>   steps_;
+    std::vector<Range>  ranges_;
+
+    void push(OpCode op, int kind, int id, float a, float b, int src_kind = 0, int src_id = 0);
+    int  column_for(int kind, int id);
+};
@@ -0,0 +1,237 @@
+// ============================================================================
+// RosterWorkspace.cpp — Deduplicated multi-roster store
+// ============================================================================
+
+#include "RosterWorkspace.hpp"
+#include <algorithm>
+#include <cstring>
+
+// ============================================================================
+// RecordStore
+// ============================================================================
+
+// Multiply-xorshift over 8-byte words. Not cryptographic: equal hashes are
+// confirmed with memcmp before a blob is shared.
+uint64_t RecordStore::hash(const uint8_t* bytes, size_t length) {
+    uint64_t h = 0x9E3779B97F4A7C15ull ^ length;
+    size_t i = 0;
+    for (; i + 8 <= length; i += 8) {
+        uint64_t w;
+        std::memcpy(&w, bytes + i, 8);
+        h = (h ^ w) * 0xFF51AFD7ED558CCDull;
+        h ^= h >> 32;
+    }
+    uint64_t tail = 0;
+    std::memcpy(&tail, bytes + i, length - i);
+    h = (h ^ tail) * 0xC4CEB9FE1A85EC53ull;
+    return h ^ (h >> 29);
+}
+
+const RecordStore::Blob* RecordStore::intern(const uint8_t* bytes, size_t length) {
+    uint64_t h = hash(bytes, length);
+    auto range = blobs_.equal_range(h);
+    for (auto it = range.first; it != range.second; ++it) {
+        Blob& b = *it->second;
+        if (b.bytes.size() == length && std::memcmp(b.bytes.data(), bytes, length) == 0) {
+            ++b.refs;
+            return &b;
+        }
+    }
+    std::unique_ptr<Blob> blob(new Blob{ h, 1, std::vector<uint8_t>(bytes, bytes + length) });
+    const Blob* out = blob.get();
+    blobs_.emplace(h, std::move(blob));
+    stored_bytes_ += length;
+    return out;
+}
+
+void RecordStore::release(const Blob* blob) {
+    if (!blob) return;
+    auto range = blobs_.equal_range(blob->hash);
+    for (auto it = range.first; it != range.second; ++it) {
+        if (it->second.get() != blob) continue;
+        if (--it->second->refs == 0) {
+            stored_bytes_ -= blob->bytes.size();
+            blobs_.erase(it);
+        }
+        return;
+    }
+}
+
+// ============================================================================
+// Rosters
+// ============================================================================
+
+RosterWorkspace::Roster* RosterWorkspace::find(int id, const char* what) {
+    return const_cast<Roster*>(static_cast<const RosterWorkspace*>(this)->find(id, what));
+}
+
+const RosterWorkspace::Roster* RosterWorkspace::find(int id, const char* what) const {
+    if (id < 0 || id >= static_cast<int>(rosters_.size()) || !rosters_[id].live) {
+        roster_fail(ROSTER_ERR_OUT_OF_RANGE, std::string("RosterWorkspace::") + what + ": no such roster");
+        return nullptr;
+    }
+    return &rosters_[id];
+}
+
+// Segments in file order: GAP_CHUNK pieces up to each table, then one per
+// record. A table that overlaps an earlier one or runs past the end is left
+// to the gap chunks.
+void RosterWorkspace::ingest(Roster& r, const uint8_t* bytes) {
+    struct Table { size_t offset; size_t record_size; int count; bool players; };
+    const RosterEditor::TableLayout& layout = r.layout;
+    Table tables[2] = {
+        { layout.player_offset, layout.player_record_size, layout.player_count, true },
+        { layout.team_offset,   layout.team_record_size,   layout.team_count,   false },
+    };
+    if (tables[1].offset < tables[0].offset) std::swap(tables[0], tables[1]);
+
+    size_t pos = 0;
+    auto add = [&](size_t length) {
+        r.segments.push_back({ pos, store_.intern(bytes + pos, length) });
+        pos += length;
+    };
+    auto add_gap = [&](size_t end) {
+        while (pos < end) add(std::min(GAP_CHUNK, end - pos));
+    };
+
+    bool players_stored = false;
+    for (const Table& t : tables) {
+        if (t.count <= 0 || t.record_size == 0) continue;
+        size_t end = t.offset + static_cast<size_t>(t.count) * t.record_size;
+        if (t.offset < pos || end > r.length) continue;
+        add_gap(t.offset);
+        if (t.players) {
+            r.first_player_segment = r.segments.size();
+            players_stored = true;
+        }
+        for (int i = 0; i < t.count; ++i) add(t.record_size);
+    }
+    add_gap(r.length);
+    if (!players_stored) r.layout.player_count = 0;
+}
+
+void RosterWorkspace::materialize(const Roster& r, uint8_t* out) const {
+    for (const Segment& seg : r.segments) {
+        std::memcpy(out + seg.offset, seg.blob->bytes.data(), seg.blob->bytes.size());
+    }
+}
+
+void RosterWorkspace::drop_segments(Roster& r) {
+    for (const Segment& seg : r.segments) store_.release(seg.blob);
+    r.segments.clear();
+}
+
+int RosterWorkspace::add_roster(const std::string& name, size_t buffer_ptr, int buffer_length) {
+    uint8_t* buffer = reinterpret_cast<uint8_t*>(buffer_ptr);
+    if (!buffer || buffer_length < 16) {
+        roster_fail(ROSTER_ERR_INVALID_ARGUMENT, "RosterWorkspace::add_roster: invalid buffer");
+        return -1;
+    }
+    rosters_.emplace_back();
+    Roster& r = rosters_.back();
+    r.live   = true;
+    r.name   = name;
+    r.length = static_cast<size_t>(buffer_length);
+    r.layout = RosterEditor::discover_layout(buffer, r.length);
+    ingest(r, buffer);
+    return static_cast<int>(rosters_.size()) - 1;
+}
+
+bool RosterWorkspace::remove_roster(int id) {
+    Roster* r = find(id, "remove_roster");
+    if (!r) return false;
+    drop_segments(*r);
+    std::vector<uint8_t>().swap(r->working);
+    r->name.clear();
+    r->live = false;
+    return true;
+}
+
+int RosterWorkspace::get_roster_count() const {
+    return static_cast<int>(std::count_if(rosters_.begin(), rosters_.end(),
+                                          [](const Roster& r) { return r.live; }));
+}
+
+std::string RosterWorkspace::get_roster_name(int id) const {
+    const Roster* r = find(id, "get_roster_name");
+    return r ? r->name : std::string();
+}
+
+int RosterWorkspace::get_roster_length(int id) const {
+    const Roster* r = find(id, "get_roster_length");
+    return r ? static_cast<int>(r->length) : 0;
+}
+
+int RosterWorkspace::export_roster(int id, size_t out_ptr) const {
+    const Roster* r = find(id, "export_roster");
+    if (!r) return 0;
+    uint8_t* out = reinterpret_cast<uint8_t*>(out_ptr);
+    if (!out) {
+        roster_fail(ROSTER_ERR_INVALID_ARGUMENT, "RosterWorkspace::export_roster: null output");
+        return 0;
+    }
+    materialize(*r, out);
+    return static_cast<int>(r->length);
+}
+
+int RosterWorkspace::get_logical_bytes() const {
+    size_t total = 0;
+    for (const Roster& r : rosters_) if (r.live) total += r.length;
+    return static_cast<int>(total);
+}
+
+// ============================================================================
+// Editing
+// ============================================================================
+
+bool RosterWorkspace::checkout(int id, RosterEditor& editor) {
+    Roster* r = find(id, "checkout");
+    if (!r) return false;
+    if (r->working.empty()) {
+        r->working.resize(r->length);
+        materialize(*r, r->working.data());
+    }
+    editor.init(reinterpret_cast<size_t>(r->working.data()), static_cast<int>(r->length));
+    return true;
+}
+
+bool RosterWorkspace::commit(int id) {
+    Roster* r = find(id, "commit");
+    if (!r) return false;
+    if (r->working.empty()) return true;
+    for (Segment& seg : r->segments) {
+        const uint8_t* current = r->working.data() + seg.offset;
+        size_t n = seg.blob->bytes.size();
+        if (std::memcmp(current, seg.blob->bytes.data(), n) == 0) continue;
+        const RecordStore::Blob* next = store_.intern(current, n);
+        store_.release(seg.blob);
+        seg.blob = next;
+    }
+    return true;
+}
+
+bool RosterWorkspace::release(int id) {
+    if (!commit(id)) return false;
+    std::vector<uint8_t>().swap(rosters_[id].working);
+    return true;
+}
+
+int RosterWorkspace::diff_players(int a, int b, size_t out_ptr, int max_results) const {
+    const Roster* ra = find(a, "diff_players");
+    const Roster* rb = find(b, "diff_players");
+    if (!ra || !rb) return 0;
+    if (ra->layout.player_count != rb->layout.player_count ||
+        ra->layout.player_record_size != rb->layout.player_record_size) {
+        roster_fail(ROSTER_ERR_INVALID_ARGUMENT, "RosterWorkspace::diff_players: player tables differ in shape");
+        return 0;
+    }
+    uint32_t* out = reinterpret_cast<uint32_t*>(out_ptr);
+    int found = 0;
+    for (int i = 0; i < ra->layout.player_count; ++i) {
+        if (ra->segments[ra->first_player_segment + i].blob ==
+            rb->segments[rb->first_player_segment + i].blob) continue;
+        if (out && found < max_results) out[found] = static_cast<uint32_t>(i);
+        ++found;
+    }
+    return found;
+}
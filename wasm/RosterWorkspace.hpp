@@ -0,0 +1,114 @@
+#pragma once
+// ============================================================================
+// RosterWorkspace.hpp — Several rosters in one module, stored deduplicated
+// ============================================================================
+//
+// A stored roster is an ordered list of segments covering the whole file:
+// one per player record, one per team record, and GAP_CHUNK-sized pieces of
+// every other region. Segments live in a content-addressed RecordStore keyed
+// by a 64-bit hash (confirmed with memcmp), so a record that is identical in
+// the official release, a mod and a working copy is held once. Stored blobs
+// never change; committing an edit points the roster at a new blob and
+// drops its reference to the old one (copy-on-write). Memory therefore grows
+// with what differs between rosters, not with how many are open.
+//
+// Editing goes through checkout(): the roster is materialized into a flat
+// working buffer and a RosterEditor is attached to it, so every editor
+// feature works unchanged. commit() folds the working copy back, re-hashing
+// only segments whose bytes changed; release() commits and frees it.
+// ============================================================================
+
+#include "RosterEditor.hpp"
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class RecordStore {
+public:
+    struct Blob {
+        uint64_t             hash;
+        uint32_t             refs;
+        std::vector<uint8_t> bytes;
+    };
+
+    // The shared blob holding these bytes, with one more reference.
+    const Blob* intern(const uint8_t* bytes, size_t length);
+    // Drop one reference; the blob is freed with its last one.
+    void        release(const Blob* blob);
+
+    size_t blob_count() const   { return blobs_.size(); }
+    size_t stored_bytes() const { return stored_bytes_; }
+
+    static uint64_t hash(const uint8_t* bytes, size_t length);
+
+private:
+    std::unordered_multimap<uint64_t, std::unique_ptr<Blob>> blobs_;
+    size_t stored_bytes_ = 0;
+};
+
+class RosterWorkspace {
+public:
+    static constexpr size_t GAP_CHUNK = 4096;
+
+    RosterWorkspace() = default;
+    RosterWorkspace(const RosterWorkspace&) = delete;
+    RosterWorkspace& operator=(const RosterWorkspace&) = delete;
+
+    // Copy a .ROS image into the store (the caller may free it afterwards).
+    // Returns the roster id, or -1 with ROSTER_ERR_INVALID_ARGUMENT.
+    int  add_roster(const std::string& name, size_t buffer_ptr, int buffer_length);
+    // Ids are never reused. Editors attached to the roster must not be used
+    // afterwards.
+    bool remove_roster(int id);
+
+    int         get_roster_count() const;   // Live rosters
+    std::string get_roster_name(int id) const;
+    int         get_roster_length(int id) const;
+    // Copy the committed bytes of a roster to out_ptr; returns the length.
+    int         export_roster(int id, size_t out_ptr) const;
+
+    // -- Editing -------------------------------------------------------------
+    // Materialize the roster (once) and init `editor` on the working copy.
+    bool checkout(int id, RosterEditor& editor);
+    // Store the working copy's changes. Does nothing if not checked out.
+    bool commit(int id);
+    // Commit, then free the working copy; re-checkout before editing again.
+    bool release(int id);
+
+    // Player indices whose committed records differ between two rosters with
+    // the same layout — a pointer compare per record. Writes up to
+    // max_results uint32 indices to out_ptr; returns the total found.
+    int  diff_players(int a, int b, size_t out_ptr, int max_results) const;
+
+    // -- Memory --------------------------------------------------------------
+    int  get_unique_segment_count() const { return static_cast<int>(store_.blob_count()); }
+    int  get_stored_bytes() const         { return static_cast<int>(store_.stored_bytes()); }
+    int  get_logical_bytes() const;       // Sum of live roster lengths
+
+private:
+    struct Segment {
+        size_t                   offset;
+        const RecordStore::Blob* blob;
+    };
+    struct Roster {
+        bool                      live = false;
+        std::string               name;
+        size_t                    length = 0;
+        RosterEditor::TableLayout layout {};
+        size_t                    first_player_segment = 0;
+        std::vector<Segment>      segments;
+        std::vector<uint8_t>      working;   // Flat copy while checked out
+    };
+
+    std::vector<Roster> rosters_;   // Indexed by id
+    RecordStore         store_;
+
+    Roster*       find(int id, const char* what);
+    const Roster* find(int id, const char* what) const;
+    void ingest(Roster& r, const uint8_t* bytes);
+    void materialize(const Roster& r, uint8_t* out) const;
+    void drop_segments(Roster& r);
+};
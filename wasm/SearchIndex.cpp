@@ -0,0 +1,173 @@
+// ============================================================================
+// SearchIndex.cpp — Trigram inverted index implementation
+// ============================================================================
+
+#include "SearchIndex.hpp"
+#include <algorithm>
+
+// Minimum share of the query's trigrams a document must contain.
+static constexpr float MIN_OVERLAP      = 0.5f;
+// Added to the score when the folded query is a substring of the document.
+static constexpr float SUBSTRING_BONUS  = 1.0f;
+
+static inline uint32_t pack_gram(char a, char b, char c) {
+    return (static_cast<uint32_t>(static_cast<uint8_t>(a)) << 16)
+         | (static_cast<uint32_t>(static_cast<uint8_t>(b)) << 8)
+         |  static_cast<uint32_t>(static_cast<uint8_t>(c));
+}
+
+SearchIndex::SearchIndex() {}
+
+// ============================================================================
+// Text folding
+// ============================================================================
+// Lowercase ASCII letters and digits are kept; UTF-8 Latin-1 letters are
+// folded to their base letter where it is obvious (é → e); everything else
+// becomes a word separator.
+
+std::string SearchIndex::fold(std::string_view text) {
+    std::string out;
+    out.reserve(text.size());
+    bool space = true;
+    auto emit = [&](char c) {
+        if (c == ' ') {
+            if (!space) out.push_back(' ');
+            space = true;
+        } else {
+            out.push_back(c);
+            space = false;
+        }
+    };
+
+    for (size_t i = 0; i < text.size(); ++i) {
+        uint8_t c = static_cast<uint8_t>(text[i]);
+        if (c >= 'A' && c <= 'Z') emit(static_cast<char>(c + 32));
+        else if ((c >= 'a' && c <= 'z') || (c >= '0' && c <= '9')) emit(static_cast<char>(c));
+        else if (c == '\'') continue;  // O'Neal → oneal
+        else if ((c == 0xC3) && i + 1 < text.size()) {
+            // U+00C0..U+00FF: map accented Latin-1 letters to ASCII
+            static const char LATIN1_FOLD[] =
+                "aaaaaaaceeeeiiiidnooooo ouuuuyts"   // C0..DF
+                "aaaaaaaceeeeiiiidnooooo ouuuuyty";  // E0..FF
+            uint8_t lo = static_cast<uint8_t>(text[++i]);
+            emit((lo >= 0x80 && lo <= 0xBF) ? LATIN1_FOLD[lo - 0x80] : ' ');
+        } else {
+            emit(' ');
+        }
+    }
+    if (!out.empty() && out.back() == ' ') out.pop_back();
+    return out;
+}
+
+// Every word contributes " ab", "abc", ... and, for documents, "yz " so full
+// words rank above prefixes. Queries skip the trailing pad (still typing).
+void SearchIndex::trigrams(const std::string& folded, bool pad_end, std::vector<uint32_t>& out) {
+    out.clear();
+    size_t start = 0;
+    while (start < folded.size()) {
+        size_t end = folded.find(' ', start);
+        if (end == std::string::npos) end = folded.size();
+
+        std::string word;
+        word.reserve(end - start + 2);
+        word.push_back(' ');
+        word.append(folded, start, end - start);
+        if (pad_end) word.push_back(' ');
+
+        for (size_t i = 0; i + 2 < word.size(); ++i) {
+            out.push_back(pack_gram(word[i], word[i + 1], word[i + 2]));
+        }
+        start = end + 1;
+    }
+    std::sort(out.begin(), out.end());
+    out.erase(std::unique(out.begin(), out.end()), out.end());
+}
+
+// ============================================================================
+// Maintenance
+// ============================================================================
+
+void SearchIndex::reset(int doc_count) {
+    docs_.assign(static_cast<size_t>(std::max(doc_count, 0)), Document());
+    postings_.clear();
+    hits_.assign(docs_.size(), 0);
+    touched_.clear();
+    ranked_.clear();
+}
+
+void SearchIndex::set_document(int doc, std::string_view text) {
+    if (doc < 0 || doc >= get_document_count()) return;
+    Document& d = docs_[doc];
+    uint32_t key = static_cast<uint32_t>(doc);
+
+    // Remove the old postings (swap-erase; order inside a list is irrelevant).
+    for (uint32_t g : d.grams) {
+        auto it = postings_.find(g);
+        if (it == postings_.end()) continue;
+        std::vector<uint32_t>& list = it->second;
+        auto pos = std::find(list.begin(), list.end(), key);
+        if (pos != list.end()) {
+            *pos = list.back();
+            list.pop_back();
+        }
+        if (list.empty()) postings_.erase(it);
+    }
+
+    d.text = fold(text);
+    trigrams(d.text, true, d.grams);
+    for (uint32_t g : d.grams) postings_[g].push_back(key);
+}
+
+// ============================================================================
+// Query
+// ============================================================================
+
+int SearchIndex::query(std::string_view text, uint32_t* out, int max_results) {
+    if (!out || max_results <= 0) return 0;
+    std::string q = fold(text);
+    if (q.empty()) return 0;
+
+    std::vector<uint32_t>& grams = query_grams_;
+    trigrams(q, false, grams);
+
+    ranked_.clear();
+    if (grams.empty()) {
+        // Single-character query: no trigram to look up, so fall back to a
+        // word-prefix scan — still cheap at ~1.8k short documents.
+        for (size_t i = 0; i < docs_.size(); ++i) {
+            const std::string& t = docs_[i].text;
+            size_t pos = t.find(q);
+            if (pos != std::string::npos && (pos == 0 || t[pos - 1] == ' ')) {
+                ranked_.emplace_back(1.0f / (1.0f + static_cast<float>(t.size())), static_cast<uint32_t>(i));
+            }
+        }
+    } else {
+        touched_.clear();
+        for (uint32_t g : grams) {
+            auto it = postings_.find(g);
+            if (it == postings_.end()) continue;
+            for (uint32_t doc : it->second) {
+                if (hits_[doc]++ == 0) touched_.push_back(doc);
+            }
+        }
+
+        const float qn = static_cast<float>(grams.size());
+        const uint16_t min_hits = static_cast<uint16_t>(std::max(1.0f, qn * MIN_OVERLAP));
+        for (uint32_t doc : touched_) {
+            uint16_t h = hits_[doc];
+            hits_[doc] = 0;
+            if (h < min_hits) continue;
+            float score = 2.0f * h / (qn + static_cast<float>(docs_[doc].grams.size()));
+            if (docs_[doc].text.find(q) != std::string::npos) score += SUBSTRING_BONUS;
+            ranked_.emplace_back(score, doc);
+        }
+    }
+
+    int n = std::min(max_results, static_cast<int>(ranked_.size()));
+    auto better = [](const std::pair<float, uint32_t>& a, const std::pair<float, uint32_t>& b) {
+        return a.first != b.first ? a.first > b.first : a.second < b.second;
+    };
+    std::partial_sort(ranked_.begin(), ranked_.begin() + n, ranked_.end(), better);
+    for (int i = 0; i < n; ++i) out[i] = ranked_[i].second;
+    return n;
+}
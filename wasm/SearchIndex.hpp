@@ -0,0 +1,56 @@
+#pragma once
+// ============================================================================
+// SearchIndex.hpp — Trigram inverted index for fuzzy name search
+// ============================================================================
+//
+// Documents are short strings (player "First Last", team "City Name") keyed
+// by a dense slot number. Text is folded to lowercase alphanumerics and
+// split into trigrams, with a leading space per word so prefixes match
+// while the user is still typing ("leb" → " le", "leb").
+//
+// Queries score each candidate by trigram overlap (Dice coefficient), which
+// tolerates typos and transpositions, and add a bonus for exact substring
+// hits. Updating a document only touches the posting lists of its old and
+// new trigrams.
+// ============================================================================
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+class SearchIndex {
+public:
+    SearchIndex();
+
+    // Drop everything and size the index for `doc_count` empty documents.
+    void reset(int doc_count);
+
+    // Replace the text of one document (incremental).
+    void set_document(int doc, std::string_view text);
+
+    // Write up to `max_results` doc slots, best first. Returns the count.
+    int query(std::string_view text, uint32_t* out, int max_results);
+
+    int get_document_count() const { return static_cast<int>(docs_.size()); }
+
+private:
+    struct Document {
+        std::string           text;    // Folded text (lowercase, single spaces)
+        std::vector<uint32_t> grams;   // Distinct trigrams, sorted
+    };
+
+    std::vector<Document> docs_;
+    std::unordered_map<uint32_t, std::vector<uint32_t>> postings_;
+
+    // Query scratch space — kept across calls to avoid per-keystroke allocs.
+    std::vector<uint16_t> hits_;
+    std::vector<uint32_t> touched_;
+    std::vector<uint32_t> query_grams_;
+    std::vector<std::pair<float, uint32_t>> ranked_;
+
+    static std::string fold(std::string_view text);
+    static void        trigrams(const std::string& folded, bool pad_end, std::vector<uint32_t>& out);
+};
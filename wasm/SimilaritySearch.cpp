@@ -0,0 +1,153 @@
+// ============================================================================
+// SimilaritySearch.cpp — Weighted nearest-neighbour scan over PlayerVectors
+// ============================================================================
+
+#include "SimilaritySearch.hpp"
+#include "OverallModel.hpp"
+#include "RosterStatus.hpp"
+#include <algorithm>
+#include <cmath>
+
+// ============================================================================
+// PlayerVectors
+// ============================================================================
+
+PlayerVectors::PlayerVectors()
+    : player_count_(0), dirty_(0)
+{}
+
+void PlayerVectors::reset(int player_count) {
+    player_count_ = std::max(player_count, 0);
+    columns_.assign(static_cast<size_t>(DIMS) * player_count_, 0.0f);
+    meta_.assign(static_cast<size_t>(player_count_), Meta{ 0, 0, 0 });
+    dirty_ = DirtyPlayers(static_cast<size_t>(player_count_));
+    dirty_.mark_all();
+}
+
+// ============================================================================
+// SimilaritySearch — options
+// ============================================================================
+
+SimilaritySearch::SimilaritySearch()
+    : metric_(SIMILARITY_L2), use_tendencies_(false), group_by_(STATS_ALL), group_(-1)
+{
+    reset_weights();
+}
+
+void SimilaritySearch::set_metric(int metric) {
+    if (metric < 0 || metric >= SIMILARITY_METRIC_COUNT) {
+        roster_fail(ROSTER_ERR_INVALID_ARGUMENT, "SimilaritySearch::set_metric: unknown metric");
+        return;
+    }
+    metric_ = metric;
+}
+
+void SimilaritySearch::set_rating_weight(int rating_id, double w) {
+    if (rating_id < 0 || rating_id >= PlayerVectors::RATING_DIMS || !(w >= 0)) {
+        roster_fail(ROSTER_ERR_INVALID_ARGUMENT, "SimilaritySearch::set_rating_weight: bad rating or weight");
+        return;
+    }
+    weights_[rating_id] = static_cast<float>(w);
+}
+
+void SimilaritySearch::set_tendency_weight(int tendency_id, double w) {
+    if (tendency_id < 0 || tendency_id >= PlayerVectors::TENDENCY_DIMS || !(w >= 0)) {
+        roster_fail(ROSTER_ERR_INVALID_ARGUMENT, "SimilaritySearch::set_tendency_weight: bad tendency or weight");
+        return;
+    }
+    weights_[PlayerVectors::RATING_DIMS + tendency_id] = static_cast<float>(w);
+}
+
+void SimilaritySearch::set_use_tendencies(bool enabled) {
+    use_tendencies_ = enabled;
+}
+
+void SimilaritySearch::reset_weights() {
+    std::fill(weights_, weights_ + PlayerVectors::DIMS, 1.0f);
+}
+
+void SimilaritySearch::set_group(int group_by, int group) {
+    if (RosterStats::group_count(group_by) == 0) {
+        roster_fail(ROSTER_ERR_INVALID_ARGUMENT, "SimilaritySearch::set_group: unknown grouping");
+        return;
+    }
+    group_by_ = group_by;
+    group_    = group < 0 ? -1 : group;
+}
+
+bool SimilaritySearch::in_group(const PlayerVectors::Meta& m) const {
+    if (group_ < 0) return true;
+    switch (group_by_) {
+        case STATS_BY_TEAM:          return m.team == group_;
+        case STATS_BY_POSITION:      return m.row == group_;
+        case STATS_BY_TEAM_POSITION: return m.team * OverallModel::ROW_COUNT + m.row == group_;
+        default:                     return group_ == 0;
+    }
+}
+
+// ============================================================================
+// Scan
+// ============================================================================
+// One pass per weighted dimension over contiguous columns. L2 accumulates
+// w·(x − t)² per player; cosine accumulates w·x·t and w·x² and finishes
+// with the target's norm. Zero-weight dimensions are skipped entirely.
+
+int SimilaritySearch::run(const PlayerVectors& vectors, int target, Match* out, int max_results) const {
+    const int n = vectors.player_count();
+    if (target < 0 || target >= n) {
+        roster_fail(ROSTER_ERR_OUT_OF_RANGE, "SimilaritySearch::run: target out of range");
+        return 0;
+    }
+
+    const int dims = use_tendencies_ ? PlayerVectors::DIMS : PlayerVectors::RATING_DIMS;
+    std::vector<float> acc(static_cast<size_t>(n), 0.0f);
+    std::vector<float> norm(metric_ == SIMILARITY_COSINE ? static_cast<size_t>(n) : 0, 0.0f);
+    float target_norm = 0.0f;
+
+    for (int d = 0; d < dims; ++d) {
+        const float w = weights_[d];
+        if (w == 0.0f) continue;
+        const float* col = vectors.column(d);
+        const float t = col[target];
+        float* a = acc.data();
+        if (metric_ == SIMILARITY_L2) {
+            for (int i = 0; i < n; ++i) {
+                float diff = col[i] - t;
+                a[i] += w * diff * diff;
+            }
+        } else {
+            float* s = norm.data();
+            const float wt = w * t;
+            for (int i = 0; i < n; ++i) {
+                a[i] += wt * col[i];
+                s[i] += w * col[i] * col[i];
+            }
+            target_norm += wt * t;
+        }
+    }
+
+    std::vector<Match> ranked;
+    ranked.reserve(static_cast<size_t>(n));
+    for (int i = 0; i < n; ++i) {
+        const PlayerVectors::Meta& m = vectors.meta(i);
+        if (i == target || !m.live || !in_group(m)) continue;
+        float distance;
+        if (metric_ == SIMILARITY_L2) {
+            distance = std::sqrt(acc[i]);
+        } else {
+            float denom = std::sqrt(norm[i] * target_norm);
+            distance = denom > 0.0f ? 1.0f - acc[i] / denom : 1.0f;
+        }
+        ranked.push_back({ i, distance });
+    }
+
+    if (out && max_results > 0) {
+        size_t keep = std::min(ranked.size(), static_cast<size_t>(max_results));
+        std::partial_sort(ranked.begin(), ranked.begin() + keep, ranked.end(),
+            [](const Match& a, const Match& b) {
+                return a.distance != b.distance ? a.distance < b.distance : a.player < b.player;
+            });
+        std::copy(ranked.begin(), ranked.begin() + keep, out);
+    }
+    return static_cast<int>(ranked.size());
+}
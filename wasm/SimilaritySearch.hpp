@@ -0,0 +1,110 @@
+#pragma once
+// ============================================================================
+// SimilaritySearch.hpp — "Players most like X" over rating vectors
+// ============================================================================
+//
+// Every player is a vector of the 43 ratings (display units), optionally
+// followed by the 58 tendencies. A query ranks all live players by their
+// weighted distance to one target player:
+//
+//     SimilaritySearch s;
+//     s.set_metric(SIMILARITY_COSINE);
+//     s.set_use_tendencies(true);
+//     s.set_rating_weight(RAT_OVERALL, 0);   // Ignore the derived overall
+//     s.set_group(STATS_BY_POSITION, 2);     // Small forwards only
+//     editor.find_similar(s, 16, out_ptr, 10);
+//
+// PlayerVectors is the editor's columnar float copy of those values: one
+// contiguous column per dimension, so a query is a brute-force scan in which
+// each dimension is one branch-free loop over all players that the compiler
+// vectorizes (-msimd128). Columns are refreshed lazily, only for players the
+// write barrier marked since the last query.
+// ============================================================================
+
+#include "RosterStats.hpp"
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+enum SimilarityMetric {
+    SIMILARITY_L2 = 0,    // sqrt(Σ w·(a − b)²)
+    SIMILARITY_COSINE,    // 1 − Σ w·a·b / (‖a‖w · ‖b‖w)
+    SIMILARITY_METRIC_COUNT
+};
+
+class PlayerVectors {
+public:
+    static constexpr int RATING_DIMS   = 43;   // RAT_COUNT
+    static constexpr int TENDENCY_DIMS = 58;   // TEND_COUNT
+    static constexpr int DIMS          = RATING_DIMS + TENDENCY_DIMS;
+
+    // Per-player state kept beside the columns.
+    struct Meta {
+        uint8_t live;   // Non-null record
+        uint8_t team;   // VITAL_TEAM_ID1 byte
+        uint8_t row;    // OverallModel position row 0..5
+    };
+
+    PlayerVectors();
+
+    // New table: size the columns and mark every player for sampling.
+    void reset(int player_count);
+    void mark_dirty(int player) { dirty_.mark(player); }
+
+    // Re-sample marked players: sample(player, values, meta) fills DIMS
+    // floats and the player's Meta.
+    template <typename Fn>
+    void refresh(Fn sample);
+
+    int          player_count() const  { return player_count_; }
+    const float* column(int dim) const { return columns_.data() + static_cast<size_t>(dim) * player_count_; }
+    const Meta&  meta(int player) const { return meta_[player]; }
+
+private:
+    int                 player_count_;
+    std::vector<float>  columns_;   // DIMS × player_count, column-major
+    std::vector<Meta>   meta_;
+    DirtyPlayers        dirty_;
+};
+
+template <typename Fn>
+void PlayerVectors::refresh(Fn sample) {
+    float values[DIMS];
+    dirty_.drain([&](int player) {
+        sample(player, values, meta_[player]);
+        for (int d = 0; d < DIMS; ++d) columns_[static_cast<size_t>(d) * player_count_ + player] = values[d];
+    });
+}
+
+class SimilaritySearch {
+public:
+    // Packed result record, 8 bytes, for JS typed-array reads.
+    struct Match {
+        int32_t player;
+        float   distance;   // Metric value; smaller is more similar
+    };
+
+    SimilaritySearch();
+
+    // -- Options (bad values report ROSTER_ERR_INVALID_ARGUMENT) -------------
+    void set_metric(int metric);                        // SimilarityMetric, default L2
+    void set_rating_weight(int rating_id, double w);    // >= 0, default 1
+    void set_tendency_weight(int tendency_id, double w);
+    void set_use_tendencies(bool enabled);              // Default off: ratings only
+    void reset_weights();
+    // Only rank players in one StatsGroupBy group; group -1 (default) = all.
+    void set_group(int group_by, int group);
+
+    // Rank every live player except the target. Writes the closest
+    // max_results to out (ties by index) and returns how many were ranked.
+    int run(const PlayerVectors& vectors, int target, Match* out, int max_results) const;
+
+private:
+    int   metric_;
+    bool  use_tendencies_;
+    int   group_by_;
+    int   group_;
+    float weights_[PlayerVectors::DIMS];
+
+    bool in_group(const PlayerVectors::Meta& m) const;
+};
@@ -0,0 +1,132 @@
+// ============================================================================
+// SnapshotStore.cpp — Copy-on-write snapshot implementation
+// ============================================================================
+
+#include "SnapshotStore.hpp"
+#include <algorithm>
+#include <cstring>
+#include <unordered_set>
+
+SnapshotStore::SnapshotStore()
+    : buffer_(nullptr), buffer_length_(0)
+{}
+
+void SnapshotStore::reset(uint8_t* buffer, size_t buffer_length) {
+    buffer_ = buffer;
+    buffer_length_ = buffer_length;
+    origin_.clear();
+    current_.clear();
+    snapshots_.clear();
+    size_t pages = (buffer_length + PAGE_SIZE - 1) / PAGE_SIZE;
+    dirty_.assign((pages + 63) / 64, 0);
+}
+
+// The final page may be short; everything past the buffer end stays zero.
+size_t SnapshotStore::page_bytes(uint32_t page) const {
+    size_t start = static_cast<size_t>(page) * PAGE_SIZE;
+    return std::min(PAGE_SIZE, buffer_length_ - start);
+}
+
+SnapshotStore::PageRef SnapshotStore::capture(uint32_t page) const {
+    auto copy = std::make_shared<Page>();
+    size_t n = page_bytes(page);
+    std::memcpy(copy->bytes, buffer_ + static_cast<size_t>(page) * PAGE_SIZE, n);
+    if (n < PAGE_SIZE) std::memset(copy->bytes + n, 0, PAGE_SIZE - n);
+    return copy;
+}
+
+void SnapshotStore::copy_in(uint32_t page, const Page& src) {
+    std::memcpy(buffer_ + static_cast<size_t>(page) * PAGE_SIZE, src.bytes, page_bytes(page));
+}
+
+// ============================================================================
+// Write barrier
+// ============================================================================
+
+void SnapshotStore::before_write(size_t offset, size_t length) {
+    if (!buffer_ || length == 0 || offset >= buffer_length_) return;
+    size_t last = std::min(offset + length, buffer_length_) - 1;
+    for (uint32_t page = static_cast<uint32_t>(offset / PAGE_SIZE);
+         page <= static_cast<uint32_t>(last / PAGE_SIZE); ++page) {
+        if (is_dirty(page)) continue;
+        if (origin_.find(page) == origin_.end()) {
+            PageRef pre = capture(page);
+            origin_.emplace(page, pre);
+            current_.emplace(page, pre);
+        }
+        set_dirty(page);
+    }
+}
+
+// ============================================================================
+// Snapshots
+// ============================================================================
+
+void SnapshotStore::create(const std::string& name) {
+    PageMap snap;
+    snap.reserve(origin_.size());
+    for (const auto& kv : origin_) {
+        uint32_t page = kv.first;
+        PageRef& cur = current_[page];
+        if (is_dirty(page)) {
+            cur = capture(page);
+            clear_dirty(page);
+        }
+        // Pages back at their load-time content need no entry at all.
+        if (cur != kv.second) snap.emplace(page, cur);
+    }
+    snapshots_[name] = std::move(snap);
+}
+
+// A snapshot without an entry for a page holds its load-time content.
+const SnapshotStore::PageRef& SnapshotStore::restore_target(const PageMap& snap, uint32_t page) const {
+    auto s = snap.find(page);
+    return (s != snap.end()) ? s->second : origin_.at(page);
+}
+
+bool SnapshotStore::pages_to_restore(const std::string& name, std::vector<uint32_t>& pages) const {
+    auto it = snapshots_.find(name);
+    if (it == snapshots_.end()) return false;
+    for (const auto& kv : origin_) {
+        uint32_t page = kv.first;
+        if (!is_dirty(page) && current_.at(page) == restore_target(it->second, page)) continue;
+        pages.push_back(page);
+    }
+    return true;
+}
+
+bool SnapshotStore::restore(const std::string& name, std::vector<uint32_t>* changed_pages) {
+    std::vector<uint32_t> pages;
+    if (!pages_to_restore(name, pages)) return false;
+    const PageMap& snap = snapshots_.find(name)->second;
+
+    for (uint32_t page : pages) {
+        const PageRef& target = restore_target(snap, page);
+        copy_in(page, *target);
+        current_[page] = target;
+        clear_dirty(page);
+    }
+    if (changed_pages) changed_pages->insert(changed_pages->end(), pages.begin(), pages.end());
+    return true;
+}
+
+bool SnapshotStore::remove(const std::string& name) {
+    return snapshots_.erase(name) != 0;
+}
+
+std::vector<std::string> SnapshotStore::names() const {
+    std::vector<std::string> out;
+    out.reserve(snapshots_.size());
+    for (const auto& kv : snapshots_) out.push_back(kv.first);
+    return out;
+}
+
+size_t SnapshotStore::memory_bytes() const {
+    std::unordered_set<const Page*> distinct;
+    for (const auto& kv : origin_)  distinct.insert(kv.second.get());
+    for (const auto& kv : current_) distinct.insert(kv.second.get());
+    for (const auto& snap : snapshots_) {
+        for (const auto& kv : snap.second) distinct.insert(kv.second.get());
+    }
+    return distinct.size() * PAGE_SIZE;
+}
@@ -0,0 +1,79 @@
+#pragma once
+// ============================================================================
+// SnapshotStore.hpp — Page-granular copy-on-write snapshots of the roster
+// ============================================================================
+//
+// The live roster stays a single flat buffer (Player/Team write straight into
+// it). Every write path calls before_write() first, which:
+//   - saves the page's load-time content the first time it is touched, and
+//   - marks the page dirty since the last snapshot/restore.
+//
+// A snapshot is a sparse map page → content for the pages touched since load.
+// Pages unchanged since the previous capture share the same copy, so N
+// branches cost roughly (touched pages + pages that differ per branch) × 4 KiB.
+// Restoring only copies pages whose content actually differs.
+// ============================================================================
+
+#include <cstdint>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class SnapshotStore {
+public:
+    static constexpr size_t PAGE_SIZE = 4096;
+
+    SnapshotStore();
+
+    // Forget all snapshots and start tracking a new buffer.
+    void reset(uint8_t* buffer, size_t buffer_length);
+
+    // Must be called BEFORE bytes [offset, offset + length) are modified.
+    void before_write(size_t offset, size_t length);
+
+    // Capture the current state under `name` (replaces an existing snapshot).
+    void create(const std::string& name);
+
+    // Bring the buffer back to snapshot `name`. Returns false if unknown.
+    // `changed_pages` (optional) receives the page indices that were rewritten.
+    bool restore(const std::string& name, std::vector<uint32_t>* changed_pages = nullptr);
+
+    // The pages restore(name) would rewrite, without touching the buffer, so
+    // callers can run their own write barriers first. False if unknown.
+    bool pages_to_restore(const std::string& name, std::vector<uint32_t>& pages) const;
+
+    bool remove(const std::string& name);
+    bool has(const std::string& name) const { return snapshots_.count(name) != 0; }
+    int  count() const { return static_cast<int>(snapshots_.size()); }
+    std::vector<std::string> names() const;
+
+    // Distinct page copies currently held (origin + all snapshots), in bytes.
+    size_t memory_bytes() const;
+
+private:
+    struct Page {
+        uint8_t bytes[PAGE_SIZE];
+    };
+    using PageRef  = std::shared_ptr<const Page>;
+    using PageMap  = std::unordered_map<uint32_t, PageRef>;
+
+    uint8_t* buffer_;
+    size_t   buffer_length_;
+
+    PageMap  origin_;     // Load-time content of every page touched since load
+    PageMap  current_;    // Last captured content; equals the buffer unless dirty
+    std::vector<uint64_t> dirty_;   // Bitmap: page written since last capture
+    std::map<std::string, PageMap> snapshots_;
+
+    PageRef capture(uint32_t page) const;
+    const PageRef& restore_target(const PageMap& snap, uint32_t page) const;
+    void    copy_in(uint32_t page, const Page& src);
+    size_t  page_bytes(uint32_t page) const;
+
+    bool is_dirty(uint32_t page) const  { return (dirty_[page >> 6] >> (page & 63)) & 1u; }
+    void set_dirty(uint32_t page)       { dirty_[page >> 6] |=  (uint64_t(1) << (page & 63)); }
+    void clear_dirty(uint32_t page)     { dirty_[page >> 6] &= ~(uint64_t(1) << (page & 63)); }
+};
@@ -0,0 +1,270 @@
+// ============================================================================
+// TaskScheduler.cpp — Worker pool implementation
+// ============================================================================
+
+#include "TaskScheduler.hpp"
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <memory>
+
+TaskScheduler& TaskScheduler::shared() {
+#if ROSTER_HAS_THREADS
+    static TaskScheduler pool(std::min(MAX_WORKERS,
+        std::max(1, static_cast<int>(std::thread::hardware_concurrency()) - 1)));
+#else
+    static TaskScheduler pool(0);
+#endif
+    return pool;
+}
+
+// Run a task on the current thread, capturing what it reported through
+// roster_fail() (the status slot is thread-local, so it must be copied out).
+void TaskScheduler::run(const Task& task, Result& out) {
+    roster_clear_status();
+#if defined(__cpp_exceptions)
+    try {
+        out.value = task();
+    } catch (const std::exception& e) {
+        // roster_fail() records before throwing; anything else is unexpected.
+        if (roster_last_status() == ROSTER_OK) {
+            out.status = ROSTER_ERR_INTERNAL;
+            out.error  = e.what();
+            return;
+        }
+        out.value = 0;
+    }
+#else
+    out.value = task();
+#endif
+    out.status = roster_last_status();
+    out.error  = roster_last_error();
+}
+
+#if ROSTER_HAS_THREADS
+
+// ============================================================================
+// Threaded implementation
+// ============================================================================
+
+TaskScheduler::TaskScheduler(int workers)
+    : next_handle_(1), stopping_(false)
+{
+    for (int i = 0; i < workers; ++i) {
+        workers_.emplace_back([this] { worker_loop(); });
+    }
+}
+
+TaskScheduler::~TaskScheduler() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    work_ready_.notify_all();
+    for (auto& t : workers_) t.join();
+}
+
+int TaskScheduler::worker_count() const {
+    return static_cast<int>(workers_.size());
+}
+
+void TaskScheduler::worker_loop() {
+    for (;;) {
+        std::function<void()> job;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            work_ready_.wait(lock, [this] { return stopping_ || !queue_.empty(); });
+            if (queue_.empty()) return;   // stopping_ and drained
+            job = std::move(queue_.front());
+            queue_.pop_front();
+        }
+        job();
+    }
+}
+
+void TaskScheduler::enqueue(std::function<void()> job) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        queue_.push_back(std::move(job));
+    }
+    work_ready_.notify_one();
+}
+
+int TaskScheduler::submit(Task task) {
+    if (workers_.empty()) {
+        Result r;
+        run(task, r);
+        r.done = true;
+        std::lock_guard<std::mutex> lock(mutex_);
+        int handle = next_handle_++;
+        results_.emplace(handle, std::move(r));
+        return handle;
+    }
+
+    int handle;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        handle = next_handle_++;
+        results_.emplace(handle, Result());
+    }
+    enqueue([this, handle, task = std::move(task)] {
+        Result r;
+        run(task, r);
+        r.done = true;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            results_[handle] = std::move(r);
+        }
+        task_done_.notify_all();
+    });
+    return handle;
+}
+
+bool TaskScheduler::is_done(int handle) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = results_.find(handle);
+    return it == results_.end() || it->second.done;
+}
+
+int TaskScheduler::wait(int handle) {
+    Result r;
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        auto it = results_.find(handle);
+        if (it == results_.end()) {
+            lock.unlock();
+            roster_fail(ROSTER_ERR_INVALID_ARGUMENT, "TaskScheduler::wait: unknown task handle");
+            return 0;
+        }
+        task_done_.wait(lock, [&] { return results_[handle].done; });
+        r = std::move(results_[handle]);
+        results_.erase(handle);
+    }
+    if (r.status != ROSTER_OK) roster_fail(r.status, r.error);
+    return r.value;
+}
+
+void TaskScheduler::parallel_for(size_t count, size_t grain, const Range& fn) {
+    if (count == 0) return;
+    grain = std::max<size_t>(grain, 1);
+    size_t chunks = (count + grain - 1) / grain;
+    if (workers_.empty() || chunks == 1) {
+        fn(0, count);
+        return;
+    }
+
+    // Chunks are claimed from a shared counter by the caller and by helper
+    // jobs. The caller only waits for chunks that were actually claimed, so
+    // helpers still sitting in the queue never hold it up.
+    //
+    // A failing chunk must neither escape a worker (std::terminate) nor
+    // unwind the caller while helpers still use `fn`. The first failure —
+    // an exception, or under -fno-exceptions a helper's roster_fail()
+    // status, which lives in that thread's status slot — is kept in State,
+    // later chunks are skipped, every claimed chunk is still counted, and
+    // the failure is re-reported on the caller once all of them are done.
+    struct State {
+        std::atomic<size_t>     next{0};
+        std::atomic<size_t>     finished{0};
+        std::atomic<bool>       failed{false};
+        std::mutex              m;
+        std::condition_variable cv;
+        std::exception_ptr      error;
+        RosterStatus            status = ROSTER_OK;
+        std::string             what;
+    };
+    auto state = std::make_shared<State>();
+    auto claim_and_run = [state, chunks, grain, count, &fn](bool helper) {
+        if (helper) roster_clear_status();
+        for (;;) {
+            size_t c = state->next.fetch_add(1);
+            if (c >= chunks) return;
+            if (!state->failed.load()) {
+                size_t begin = c * grain;
+#if defined(__cpp_exceptions)
+                try {
+                    fn(begin, std::min(count, begin + grain));
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(state->m);
+                    if (!state->failed.exchange(true)) state->error = std::current_exception();
+                }
+#else
+                fn(begin, std::min(count, begin + grain));
+#endif
+                if (helper && roster_last_status() != ROSTER_OK) {
+                    std::lock_guard<std::mutex> lock(state->m);
+                    if (!state->failed.exchange(true)) {
+                        state->status = roster_last_status();
+                        state->what   = roster_last_error();
+                    }
+                }
+            }
+            if (state->finished.fetch_add(1) + 1 == chunks) {
+                std::lock_guard<std::mutex> lock(state->m);
+                state->cv.notify_all();
+            }
+        }
+    };
+
+    // `fn` is only touched by helpers that claim a chunk, and every claimed
+    // chunk finishes before we return, so capturing it by reference is safe.
+    size_t helpers = std::min(workers_.size(), chunks - 1);
+    for (size_t i = 0; i < helpers; ++i) enqueue([claim_and_run] { claim_and_run(true); });
+    claim_and_run(false);
+
+    {
+        std::unique_lock<std::mutex> lock(state->m);
+        state->cv.wait(lock, [&] { return state->finished.load() == chunks; });
+    }
+#if defined(__cpp_exceptions)
+    if (state->error) std::rethrow_exception(state->error);
+#endif
+    if (state->status != ROSTER_OK) roster_fail(state->status, state->what);
+}
+
+#else
+
+// ============================================================================
+// Single-threaded implementation — everything runs inline
+// ============================================================================
+
+TaskScheduler::TaskScheduler(int)
+    : next_handle_(1)
+{}
+
+TaskScheduler::~TaskScheduler() = default;
+
+int TaskScheduler::worker_count() const {
+    return 0;
+}
+
+int TaskScheduler::submit(Task task) {
+    Result r;
+    run(task, r);
+    r.done = true;
+    int handle = next_handle_++;
+    results_.emplace(handle, std::move(r));
+    return handle;
+}
+
+bool TaskScheduler::is_done(int) const {
+    return true;
+}
+
+int TaskScheduler::wait(int handle) {
+    auto it = results_.find(handle);
+    if (it == results_.end()) {
+        roster_fail(ROSTER_ERR_INVALID_ARGUMENT, "TaskScheduler::wait: unknown task handle");
+        return 0;
+    }
+    Result r = std::move(it->second);
+    results_.erase(it);
+    if (r.status != ROSTER_OK) roster_fail(r.status, r.error);
+    return r.value;
+}
+
+void TaskScheduler::parallel_for(size_t count, size_t, const Range& fn) {
+    if (count > 0) fn(0, count);
+}
+
+#endif
@@ -0,0 +1,95 @@
+#pragma once
+// ============================================================================
+// TaskScheduler.hpp — Small worker pool for bulk roster operations
+// ============================================================================
+//
+// Two entry points:
+//   - submit(): queue a task that returns an int, get a handle back right
+//     away, poll is_done() / collect with wait(). This is how JS keeps
+//     multi-megabyte work (discovery, export, diff, checksum) off the UI
+//     thread.
+//   - parallel_for(): split a range into chunks and run them on the workers
+//     plus the calling thread, blocking until done. Safe to call from inside
+//     a submitted task: the caller keeps claiming chunks itself, so it never
+//     waits on a helper that has not started.
+//
+// ROSTER_HAS_THREADS is 1 for native builds and for Emscripten builds made
+// with -pthread (make THREADS=1). Otherwise there are no workers and both
+// entry points run inline on the caller; handles are complete on return.
+// ============================================================================
+
+#include "RosterStatus.hpp"
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <unordered_map>
+
+#if !defined(__EMSCRIPTEN__) || defined(__EMSCRIPTEN_PTHREADS__)
+#define ROSTER_HAS_THREADS 1
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+#else
+#define ROSTER_HAS_THREADS 0
+#endif
+
+class TaskScheduler {
+public:
+    using Task  = std::function<int()>;
+    using Range = std::function<void(size_t begin, size_t end)>;
+
+    // Must not exceed PTHREAD_POOL_SIZE in the threaded Wasm build, or
+    // starting the pool would have to wait for the browser to spawn workers.
+    static constexpr int MAX_WORKERS = 4;
+
+    // Process-wide pool, started on first use.
+    static TaskScheduler& shared();
+
+    explicit TaskScheduler(int workers);
+    ~TaskScheduler();
+    TaskScheduler(const TaskScheduler&) = delete;
+    TaskScheduler& operator=(const TaskScheduler&) = delete;
+
+    // Queue a task. Returns a handle (> 0).
+    int  submit(Task task);
+    bool is_done(int handle) const;
+    // Block until the task finishes, release the handle and return its
+    // result. A failure recorded on the worker is re-reported here via
+    // roster_fail(). Unknown handles report ROSTER_ERR_INVALID_ARGUMENT.
+    int  wait(int handle);
+
+    // Run fn over [0, count) in chunks of at least `grain` items. If a chunk
+    // fails, the remaining chunks are skipped and the first failure (its
+    // exception, or its roster_fail() status) is re-reported on the caller
+    // once every running chunk has finished.
+    void parallel_for(size_t count, size_t grain, const Range& fn);
+
+    int  worker_count() const;
+
+private:
+    struct Result {
+        bool         done = false;
+        int          value = 0;
+        RosterStatus status = ROSTER_OK;
+        std::string  error;
+    };
+
+    int next_handle_;
+    std::unordered_map<int, Result> results_;
+
+    static void run(const Task& task, Result& out);
+
+#if ROSTER_HAS_THREADS
+    mutable std::mutex              mutex_;
+    std::condition_variable         work_ready_;
+    mutable std::condition_variable task_done_;
+    std::deque<std::function<void()>> queue_;
+    std::vector<std::thread>        workers_;
+    bool                            stopping_;
+
+    void worker_loop();
+    void enqueue(std::function<void()> job);
+#endif
+};
@@ -8,10 +8,31 @@
 // ============================================================================
 
 #include "RosterEditor.hpp"
+#include "RosterTransform.hpp"
+#include "FieldSearch.hpp"
+#include "SimilaritySearch.hpp"
+#include "RosterBalancer.hpp"
+#include "PlayerGenerator.hpp"
+#include "RosterWorkspace.hpp"
 #include <emscripten/bind.h>
+#include <emscripten/val.h>
 
 using namespace emscripten;
 
+// Uint8Array views straight onto the Wasm heap, so loads and exports copy
+// the file once. A view is detached by heap growth: JS must fill or consume
+// it before making another call into the module.
+static val prepare_load_view(RosterEditor& editor, int length) {
+    size_t ptr = editor.prepare_load(length);
+    if (!ptr) return val::null();
+    return val(typed_memory_view(static_cast<size_t>(length), reinterpret_cast<uint8_t*>(ptr)));
+}
+
+static val buffer_view(const RosterEditor& editor) {
+    const uint8_t* data = reinterpret_cast<const uint8_t*>(editor.get_buffer_ptr());
+    return val(typed_memory_view(static_cast<size_t>(editor.get_buffer_length()), data));
+}
+
 EMSCRIPTEN_BINDINGS(roster_editor_module) {
 
     class_<Player>("Player")
@@ -30,6 +51,10 @@ EMSCRIPTEN_BINDINGS(roster_editor_module) {
         .function("set_overall_rating",      &Player::set_overall_rating)
         .function("get_first_name",          &Player::get_first_name)
         .function("get_last_name",           &Player::get_last_name)
+        .function("get_first_name_id",       &Player::get_first_name_id)
+        .function("get_last_name_id",        &Player::get_last_name_id)
+        .function("set_first_name",          &Player::set_first_name)
+        .function("set_last_name",           &Player::set_last_name)
         .function("get_position",            &Player::get_position)
         // -- Data-driven (covers ALL ratings/tendencies) --
         .function("get_rating_by_id",        &Player::get_rating_by_id)
@@ -40,6 +65,15 @@ EMSCRIPTEN_BINDINGS(roster_editor_module) {
         .function("set_hot_zone",            &Player::set_hot_zone)
         .function("get_sig_skill",           &Player::get_sig_skill)
         .function("set_sig_skill",           &Player::set_sig_skill)
+        // -- Block access (heap pointers, one value per byte) --
+        .function("read_tendency_block",     &Player::read_tendency_block)
+        .function("write_tendency_block",    &Player::write_tendency_block)
+        .function("read_hot_zone_block",     &Player::read_hot_zone_block)
+        .function("write_hot_zone_block",    &Player::write_hot_zone_block)
+        .function("read_sig_skill_block",    &Player::read_sig_skill_block)
+        .function("write_sig_skill_block",   &Player::write_sig_skill_block)
+        .function("read_gear_block",         &Player::read_gear_block)
+        .function("write_gear_block",        &Player::write_gear_block)
         // -- Tendencies (bit-packed) --
         .function("get_tendency_stepback_shot_3pt",  &Player::get_tendency_stepback_shot_3pt)
         .function("set_tendency_stepback_shot_3pt",  &Player::set_tendency_stepback_shot_3pt)
@@ -80,15 +114,176 @@ EMSCRIPTEN_BINDINGS(roster_editor_module) {
         .function("set_roster_player_id",     &Team::set_roster_player_id)
         ;
 
+    class_<RosterTransform>("RosterTransform")
+        .constructor<>()
+        .function("where_positions",          &RosterTransform::where_positions)
+        .function("where_team",               &RosterTransform::where_team)
+        .function("where_range",              &RosterTransform::where_range)
+        .function("scale",                    &RosterTransform::scale)
+        .function("add",                      &RosterTransform::add)
+        .function("clamp",                    &RosterTransform::clamp)
+        .function("set",                      &RosterTransform::set)
+        .function("copy_from",                &RosterTransform::copy_from)
+        .function("clear",                    &RosterTransform::clear)
+        .function("compile",                  &RosterTransform::compile)
+        .function("get_step_count",           &RosterTransform::get_step_count)
+        ;
+
+    class_<FieldSearch>("FieldSearch")
+        .constructor<>()
+        .function("add",                      &FieldSearch::add)
+        .function("clear",                    &FieldSearch::clear)
+        .function("get_observation_count",    &FieldSearch::get_observation_count)
+        .function("set_transform",            &FieldSearch::set_transform)
+        .function("set_widths",               &FieldSearch::set_widths)
+        .function("set_tolerance",            &FieldSearch::set_tolerance)
+        .function("set_byte_range",           &FieldSearch::set_byte_range)
+        .function("set_min_matches",          &FieldSearch::set_min_matches)
+        ;
+
+    class_<SimilaritySearch>("SimilaritySearch")
+        .constructor<>()
+        .function("set_metric",               &SimilaritySearch::set_metric)
+        .function("set_rating_weight",        &SimilaritySearch::set_rating_weight)
+        .function("set_tendency_weight",      &SimilaritySearch::set_tendency_weight)
+        .function("set_use_tendencies",       &SimilaritySearch::set_use_tendencies)
+        .function("reset_weights",            &SimilaritySearch::reset_weights)
+        .function("set_group",                &SimilaritySearch::set_group)
+        ;
+
+    class_<RosterBalancer>("RosterBalancer")
+        .constructor<>()
+        .function("set_field",                &RosterBalancer::set_field)
+        .function("add_team",                 &RosterBalancer::add_team)
+        .function("clear_teams",              &RosterBalancer::clear_teams)
+        .function("set_target",               &RosterBalancer::set_target)
+        .function("set_team_target",          &RosterBalancer::set_team_target)
+        .function("clear_targets",            &RosterBalancer::clear_targets)
+        .function("set_position_mask",        &RosterBalancer::set_position_mask)
+        .function("lock_player",              &RosterBalancer::lock_player)
+        .function("clear_locks",              &RosterBalancer::clear_locks)
+        .function("set_moves",                &RosterBalancer::set_moves)
+        .function("set_max_adjust",           &RosterBalancer::set_max_adjust)
+        .function("set_same_position_trades", &RosterBalancer::set_same_position_trades)
+        .function("set_costs",                &RosterBalancer::set_costs)
+        .function("set_iterations",           &RosterBalancer::set_iterations)
+        .function("set_restarts",             &RosterBalancer::set_restarts)
+        .function("set_seed",                 &RosterBalancer::set_seed)
+        .function("get_change_count",         &RosterBalancer::get_change_count)
+        .function("get_changes",              &RosterBalancer::get_changes)
+        .function("get_cost_before",          &RosterBalancer::get_cost_before)
+        .function("get_cost_after",           &RosterBalancer::get_cost_after)
+        ;
+
+    class_<PlayerGenerator>("PlayerGenerator")
+        .constructor<>()
+        .function("set_seed",                 &PlayerGenerator::set_seed)
+        .function("set_position",             &PlayerGenerator::set_position)
+        .function("set_quality",              &PlayerGenerator::set_quality)
+        .function("set_spread",               &PlayerGenerator::set_spread)
+        .function("set_birth_years",          &PlayerGenerator::set_birth_years)
+        .function("set_cfid_base",            &PlayerGenerator::set_cfid_base)
+        ;
+
     class_<RosterEditor>("RosterEditor")
         .constructor<>()
         .function("init",                          &RosterEditor::init)
+        .function("prepare_load",                  &prepare_load_view)
+        .function("load_prepared",                 &RosterEditor::load_prepared)
+        .function("get_load_capacity",             &RosterEditor::get_load_capacity)
         .function("get_player_count",              &RosterEditor::get_player_count)
         .function("get_player",                    &RosterEditor::get_player)
+        .function("copy_gear",                     &RosterEditor::copy_gear)
+        .function("clone_player",                  &RosterEditor::clone_player)
+        .function("swap_players",                  &RosterEditor::swap_players)
+        .function("move_player",                   &RosterEditor::move_player)
+        .function("allocate_player_slot",          &RosterEditor::allocate_player_slot)
+        .function("release_player_slot",           &RosterEditor::release_player_slot)
+        .function("get_free_slot_count",           &RosterEditor::get_free_slot_count)
         .function("get_team_count",                &RosterEditor::get_team_count)
         .function("get_team",                      &RosterEditor::get_team)
+        .function("decode_teams",                  &RosterEditor::decode_teams)
         .function("save_and_recalculate_checksum", &RosterEditor::save_and_recalculate_checksum)
+        .function("begin_export",                  &RosterEditor::begin_export)
+        .function("next_export_chunk",             &RosterEditor::next_export_chunk)
+        .function("get_export_chunk_ptr",          &RosterEditor::get_export_chunk_ptr)
         .function("get_buffer_ptr",                &RosterEditor::get_buffer_ptr)
         .function("get_buffer_length",             &RosterEditor::get_buffer_length)
+        .function("get_buffer_view",               &buffer_view)
+        // -- Name dictionary --
+        .function("get_name_count",                &RosterEditor::get_name_count)
+        .function("get_name",                      &RosterEditor::get_name)
+        .function("rename_name",                   &RosterEditor::rename_name)
+        .function("get_name_pool_ptr",             &RosterEditor::get_name_pool_ptr)
+        .function("get_name_pool_length",          &RosterEditor::get_name_pool_length)
+        .function("get_name_offsets_ptr",          &RosterEditor::get_name_offsets_ptr)
+        .function("export_player_name_ids",        &RosterEditor::export_player_name_ids)
+        // -- Fuzzy search --
+        .function("search",                        &RosterEditor::search)
+        // -- Snapshots --
+        .function("create_snapshot",               &RosterEditor::create_snapshot)
+        .function("restore_snapshot",              &RosterEditor::restore_snapshot)
+        .function("delete_snapshot",               &RosterEditor::delete_snapshot)
+        .function("has_snapshot",                  &RosterEditor::has_snapshot)
+        .function("get_snapshot_count",            &RosterEditor::get_snapshot_count)
+        .function("get_snapshot_memory",           &RosterEditor::get_snapshot_memory)
+        // -- Bulk transforms --
+        .function("apply_transform",               &RosterEditor::apply_transform)
+        // -- Overall rating --
+        .function("recompute_overalls",            &RosterEditor::recompute_overalls)
+        .function("compute_overall",               &RosterEditor::compute_overall)
+        .function("set_auto_overall",              &RosterEditor::set_auto_overall)
+        .function("get_auto_overall",              &RosterEditor::get_auto_overall)
+        .function("set_overall_weight",            &RosterEditor::set_overall_weight)
+        .function("get_overall_weight",            &RosterEditor::get_overall_weight)
+        .function("reset_overall_weights",         &RosterEditor::reset_overall_weights)
+        // -- Aggregate statistics --
+        .function("stats_summary",                 &RosterEditor::stats_summary)
+        .function("stats_histogram",               &RosterEditor::stats_histogram)
+        .function("stats_quantile",                &RosterEditor::stats_quantile)
+        .function("stats_top",                     &RosterEditor::stats_top)
+        // -- Change feed --
+        .function("drain_changes",                 &RosterEditor::drain_changes)
+        .function("get_pending_change_count",      &RosterEditor::get_pending_change_count)
+        // -- Diff, integrity scan & background tasks --
+        .function("diff_players",                  &RosterEditor::diff_players)
+        .function("diff_bit_heatmap",              &RosterEditor::diff_bit_heatmap)
+        .function("diff_bit_runs",                 &RosterEditor::diff_bit_runs)
+        .function("validate",                      &RosterEditor::validate)
+        .function("find_field",                    &RosterEditor::find_field)
+        .function("find_similar",                  &RosterEditor::find_similar)
+        .function("plan_balance",                  &RosterEditor::plan_balance)
+        .function("apply_balance",                 &RosterEditor::apply_balance)
+        .function("generate_players",              &RosterEditor::generate_players)
+        .function("init_async",                    &RosterEditor::init_async)
+        .function("load_prepared_async",           &RosterEditor::load_prepared_async)
+        .function("checksum_async",                &RosterEditor::checksum_async)
+        .function("export_async",                  &RosterEditor::export_async)
+        .function("diff_players_async",            &RosterEditor::diff_players_async)
+        .function("plan_balance_async",            &RosterEditor::plan_balance_async)
+        .function("is_task_done",                  &RosterEditor::is_task_done)
+        .function("wait_task",                     &RosterEditor::wait_task)
+        .class_function("get_worker_count",        &RosterEditor::get_worker_count)
+        // -- Status (error channel for -fno-exceptions builds) --
+        .function("get_last_status",               &RosterEditor::get_last_status)
+        .function("get_last_error",                &RosterEditor::get_last_error)
+        .function("clear_status",                  &RosterEditor::clear_status)
+        ;
+
+    class_<RosterWorkspace>("RosterWorkspace")
+        .constructor<>()
+        .function("add_roster",               &RosterWorkspace::add_roster)
+        .function("remove_roster",            &RosterWorkspace::remove_roster)
+        .function("get_roster_count",         &RosterWorkspace::get_roster_count)
+        .function("get_roster_name",          &RosterWorkspace::get_roster_name)
+        .function("get_roster_length",        &RosterWorkspace::get_roster_length)
+        .function("export_roster",            &RosterWorkspace::export_roster)
+        .function("checkout",                 &RosterWorkspace::checkout)
+        .function("commit",                   &RosterWorkspace::commit)
+        .function("release",                  &RosterWorkspace::release)
+        .function("diff_players",             &RosterWorkspace::diff_players)
+        .function("get_unique_segment_count", &RosterWorkspace::get_unique_segment_count)
+        .function("get_stored_bytes",         &RosterWorkspace::get_stored_bytes)
+        .function("get_logical_bytes",        &RosterWorkspace::get_logical_bytes)
         ;
 }
@@ -2,8 +2,13 @@
 cd /d "c:\Users\Mark Lorenz\Desktop\emsdk"
 call emsdk_env.bat
 cd /d "c:\Users\Mark Lorenz\Desktop\rostra\wasm"
-emcc --bind -O2 -std=c++17 ^
-    -s INITIAL_MEMORY=128MB ^
+rem Flavors: "noexcept" (-fno-exceptions, errors via get_last_status),
+rem "threads" (pthreads worker pool; page must be cross-origin isolated)
+set FLAVOR_FLAGS=
+if /i "%1"=="noexcept" set FLAVOR_FLAGS=-fno-exceptions
+if /i "%1"=="threads" set FLAVOR_FLAGS=-pthread -s PTHREAD_POOL_SIZE=4
+emcc --bind -O2 -std=c++17 -msimd128 %FLAVOR_FLAGS% ^
+    -s INITIAL_MEMORY=32MB ^
     -s MAXIMUM_MEMORY=512MB ^
     -s ALLOW_MEMORY_GROWTH=1 ^
     -s MODULARIZE=1 ^
@@ -11,6 +16,6 @@ emcc --bind -O2 -std=c++17 ^
     -s EXPORTED_RUNTIME_METHODS="['ccall','cwrap','HEAPU8']" ^
     -s EXPORTED_FUNCTIONS="['_malloc','_free']" ^
     -s USE_ZLIB=1 ^
-    -s ENVIRONMENT="web" ^
-    BitStream.cpp RosterEditor.cpp bindings.cpp ^
+    -s ENVIRONMENT="web,worker" ^
+    RosterStatus.cpp TaskScheduler.cpp BitStream.cpp ChangeFeed.cpp NameTable.cpp SearchIndex.cpp SnapshotStore.cpp MappedFile.cpp OverallModel.cpp RosterStats.cpp RosterTransform.cpp FieldSearch.cpp SimilaritySearch.cpp RosterBalancer.cpp PlayerGenerator.cpp RosterEditor.cpp RosterWorkspace.cpp bindings.cpp ^
     -o ../public/roster_editor.js